@@ -0,0 +1,737 @@
+# Copyright (c) 2026 The AI_X-Lab Authors
+# Copyright (c) 2016 Georgia Institute of Technology
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Run a grid of garnet_synth_traffic.py configurations from one gem5
+invocation and collect the results into a single table.
+
+A gem5 process can only instantiate one simulation, so every point of the
+sweep runs in a worker forked from this process after the configuration
+scripts have been loaded. Up to --jobs workers run at a time. Each worker
+writes its own m5out-style directory under <outdir>/sweep/<index> and
+reports its network statistics back to the parent, which writes them as
+one row of the results table.
+
+Every option of garnet_synth_traffic.py is accepted and applies to all
+points. Swept options are given with --sweep, using the option name
+without the leading dashes, e.g.
+
+  gem5.opt configs/example/garnet_sweep.py --network=garnet \\
+      --topology=Torus3D --num-cpus=64 --num-dirs=64 \\
+      --sweep synthetic=uniform_random,bit_reverse \\
+      --sweep injectionrate=0.1,0.2,0.3 \\
+      --sweep vcs-per-vnet:escape-vcs=2:1,4:1,4:2
+
+Options joined with ':' are swept together; separate --sweep arguments
+are combined as a cross product. Unless --route-cache-dir is given, the
+points share a routing table cache in <outdir>/route_cache, so that each
+topology's routes are only computed once.
+
+With --steady-state-window every point warms up, then runs until its
+average packet latency converged or its network saturated, and
+--sim-cycles only bounds its length. Throughputs are then computed over
+the measured cycles, reported with the exit cause of each point.
+
+With --warm-once the points that only differ in their injection rate
+share one warmup: a worker simulates it at the lowest of their rates,
+then forks the simulation of every point from the warm network, which
+keeps the packets in flight. Each point's statistics only cover the
+cycles after the fork.
+
+With --saturation-search the injection rate is not swept. Instead, the
+saturation injection rate of every point is found by bisection on the
+ratio of the average packet latency to the zero-load latency, and the
+results table holds one row per point.
+"""
+
+import m5
+from m5.objects import *
+from m5.util import addToPath, fatal, warn
+import argparse, copy, csv, itertools, json, os, sys, traceback
+
+addToPath("../")
+
+import garnet_synth_traffic
+
+# Network statistics reported for each point. All values are totals over
+# the virtual networks.
+NETWORK_STATS = [
+    "packets_received",
+    "packets_injected",
+    "average_packet_latency",
+    "average_hops",
+    "average_packet_network_latency",
+    "average_packet_queueing_latency",
+    "measured_cycles",
+]
+
+# Exit cause of the points the steady state detection found saturated
+SATURATED_CAUSE = "garnet network saturated"
+
+# Columns of the results table after the swept options. The names match
+# the per-point tables written by the experiment scripts.
+RESULT_COLUMNS = [
+    "injection_rate",
+    "throughput",
+    "per_node_throughput",
+    "avg_latency",
+    "avg_hops",
+    "network_latency",
+    "queueing_latency",
+    "packets_received",
+    "packets_injected",
+    "measured_cycles",
+    "exit_cause",
+]
+
+
+def parse_sweeps(sweeps):
+    """Turn the --sweep arguments into a list of (names, value tuples)."""
+    axes = []
+    for sweep in sweeps:
+        if "=" not in sweep:
+            fatal("Malformed --sweep '%s', expected name=v1,v2,..." % sweep)
+        names, values = sweep.split("=", 1)
+        names = names.split(":")
+        points = [tuple(v.split(":")) for v in values.split(",") if v]
+        for point in points:
+            if len(point) != len(names):
+                fatal(
+                    "--sweep %s: value '%s' does not give one value per "
+                    "option" % (":".join(names), ":".join(point))
+                )
+        axes.append((names, points))
+    return axes
+
+
+def expand_points(parser, base_argv, axes):
+    """Parse the arguments of every point of the sweep.
+
+    Each point is parsed as the base command line followed by its swept
+    options, so the swept values override the base ones and are checked
+    by the same parser as a single run."""
+    points = []
+    for combination in itertools.product(*[p for _, p in axes]):
+        swept = {}
+        for (names, _), values in zip(axes, combination):
+            swept.update(zip(names, values))
+        argv = base_argv + ["--%s=%s" % (n, v) for n, v in swept.items()]
+        points.append((swept, parser.parse_args(argv)))
+    return points
+
+
+def network_stats(network):
+    """Read NETWORK_STATS of network from the prepared statistics."""
+    prefix = network.path() + "."
+    wanted = {prefix + name: name for name in NETWORK_STATS}
+    values = {}
+    for stat in m5.stats.stats_list:
+        if stat.name in wanted:
+            value = stat.total
+            # 0/0 formulas of idle networks are reported as zero, like
+            # the experiment scripts did for unspecified values.
+            values[wanted[stat.name]] = 0.0 if value != value else value
+    return values
+
+
+def redirect_output(outdir):
+    """Keep the output of a worker out of the sweep's console."""
+    log = os.open(
+        os.path.join(outdir, "simout.txt"),
+        os.O_WRONLY | os.O_CREAT | os.O_TRUNC,
+        0o644,
+    )
+    os.dup2(log, sys.stdout.fileno())
+    os.dup2(log, sys.stderr.fileno())
+    os.close(log)
+
+
+def finish_point(root, outdir, exit_event):
+    """Dump the statistics of a simulated point and report them."""
+    print("Exiting @ tick", m5.curTick(), "because", exit_event.getCause())
+    m5.stats.dump()
+    result = network_stats(root.system.ruby.network)
+    result["exit_cause"] = exit_event.getCause()
+    with open(os.path.join(outdir, "result.json"), "w") as f:
+        json.dump(result, f)
+
+
+def run_point(args, outdir):
+    """Simulate one point in a freshly forked worker. Never returns."""
+    status = 1
+    try:
+        os.makedirs(outdir, exist_ok=True)
+        m5.options.outdir = outdir
+        m5.core.setOutputDir(outdir)
+        redirect_output(outdir)
+
+        root = garnet_synth_traffic.create_root(args)
+
+        # Same tick rate as garnet_synth_traffic.py
+        m5.ticks.setGlobalFrequency("2GHz")
+        m5.instantiate()
+        exit_event = m5.simulate(args.abs_max_tick)
+        finish_point(root, outdir, exit_event)
+        status = 0
+    except BaseException:
+        # os._exit() skips the interpreter's report of the exception
+        traceback.print_exc()
+        status = 1
+    finally:
+        sys.stdout.flush()
+        sys.stderr.flush()
+        os._exit(status)
+
+
+def injectors(root):
+    """The objects injecting the synthetic traffic of a simulation."""
+    kinds = (GarnetSyntheticTraffic, GarnetDirectInjector)
+    return [
+        obj.getCCObject()
+        for obj in root.descendants()
+        if isinstance(obj, kinds)
+    ]
+
+
+def run_branch(root, args, outdir):
+    """Continue a warmed-up simulation with the injection rate of one
+    point, in a process forked from the warm worker. Never returns."""
+    status = 1
+    try:
+        redirect_output(outdir)
+        for injector in injectors(root):
+            injector.setInjectionRate(args.injectionrate)
+            injector.setSimCycles(m5.curTick() + args.sim_cycles)
+        # The statistics only cover the branch
+        m5.stats.reset()
+        exit_event = m5.simulate(args.abs_max_tick)
+        finish_point(root, outdir, exit_event)
+        status = 0
+    except BaseException:
+        # os._exit() skips the interpreter's report of the exception
+        traceback.print_exc()
+        status = 1
+    finally:
+        sys.stdout.flush()
+        sys.stderr.flush()
+        os._exit(status)
+
+
+def run_warm_group(members, warmup, max_branches, warm_dir):
+    """Warm up the network once for points that only differ in their
+    injection rate, then fork the simulation of every point from the
+    warm state. The warmup injects at the rate of the first point.
+    Never returns."""
+    status = 1
+    try:
+        os.makedirs(warm_dir, exist_ok=True)
+        m5.options.outdir = warm_dir
+        m5.core.setOutputDir(warm_dir)
+        redirect_output(warm_dir)
+
+        # The injectors must not stop during the warmup
+        warm_args = copy.copy(members[0][0])
+        warm_args.sim_cycles += warmup
+        root = garnet_synth_traffic.create_root(warm_args)
+
+        m5.ticks.setGlobalFrequency("2GHz")
+        # m5.fork() refuses to copy open listener sockets
+        m5.disableAllListeners()
+        m5.instantiate()
+        exit_event = m5.simulate(warmup)
+        if exit_event.getCause() != "simulate() limit reached":
+            fatal("Warmup ended early: %s" % exit_event.getCause())
+        print("Warmed up @ tick", m5.curTick())
+
+        running = set()
+        for args, outdir in members:
+            while len(running) >= max_branches:
+                running.discard(os.wait()[0])
+            os.makedirs(outdir, exist_ok=True)
+            sys.stdout.flush()
+            sys.stderr.flush()
+            pid = m5.fork(outdir)
+            if pid == 0:
+                run_branch(root, args, outdir)
+            running.add(pid)
+        while running:
+            running.discard(os.wait()[0])
+        status = 0
+    except BaseException:
+        # os._exit() skips the interpreter's report of the exception
+        traceback.print_exc()
+        status = 1
+    finally:
+        sys.stdout.flush()
+        sys.stderr.flush()
+        os._exit(status)
+
+
+def make_row(swept, args, stats):
+    """Build the results table row of one point."""
+    received = stats.get("packets_received", 0)
+    # With --steady-state-window the stats cover less than sim_cycles
+    cycles = stats.get("measured_cycles") or args.sim_cycles
+    throughput = received / cycles
+    row = dict(swept)
+    row.update(
+        {
+            "injection_rate": args.injectionrate,
+            "throughput": "%.6f" % throughput,
+            "per_node_throughput": "%.6f" % (throughput / args.num_cpus),
+            "avg_latency": stats.get("average_packet_latency", 0),
+            "avg_hops": stats.get("average_hops", 0),
+            "network_latency": stats.get("average_packet_network_latency", 0),
+            "queueing_latency": stats.get(
+                "average_packet_queueing_latency", 0
+            ),
+            "packets_received": int(received),
+            "packets_injected": int(stats.get("packets_injected", 0)),
+            "measured_cycles": int(cycles),
+            "exit_cause": stats.get("exit_cause", ""),
+        }
+    )
+    return row
+
+
+def write_table(filename, columns, rows):
+    with open(filename, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=columns, extrasaction="ignore")
+        writer.writeheader()
+        writer.writerows(rows)
+
+
+class Scheduler:
+    """Runs simulation points in at most max_jobs forked workers.
+
+    Points are simulated in submission order. The callback of a point is
+    called in the parent with the point's network statistics, or None if
+    the worker failed, and may submit more points. A group of points
+    sharing a warmup runs in one worker, which forks a simulation per
+    point and counts as that many jobs."""
+
+    def __init__(self, max_jobs, sweep_dir):
+        self.max_jobs = max_jobs
+        self.sweep_dir = sweep_dir
+        self.pending = []
+        self.running = {}
+        self.busy = 0
+        self.num_points = 0
+        self.num_groups = 0
+        self.num_failed = 0
+
+    def next_outdir(self):
+        outdir = os.path.join(self.sweep_dir, str(self.num_points))
+        self.num_points += 1
+        return outdir
+
+    def submit(self, args, callback):
+        outdir = self.next_outdir()
+        run = lambda: run_point(args, outdir)
+        self.pending.append((run, [(outdir, callback)], 1))
+
+    def submit_warm_group(self, points, warmup):
+        """Simulate points, a list of (args, callback) that only differ
+        in their injection rate, from a single warmup."""
+        members = [(args, self.next_outdir()) for args, _ in points]
+        outputs = [(o, c) for (_, o), (_, c) in zip(members, points)]
+        warm_dir = os.path.join(self.sweep_dir, "warm%d" % self.num_groups)
+        self.num_groups += 1
+        jobs = min(len(members), self.max_jobs)
+        run = lambda: run_warm_group(members, warmup, jobs, warm_dir)
+        self.pending.append((run, outputs, jobs))
+
+    def run(self):
+        while self.pending or self.running:
+            while self.pending and (
+                not self.running
+                or self.busy + self.pending[0][2] <= self.max_jobs
+            ):
+                run, outputs, jobs = self.pending.pop(0)
+                # Flush first so buffered output is not written again by
+                # the worker
+                sys.stdout.flush()
+                sys.stderr.flush()
+                pid = os.fork()
+                if pid == 0:
+                    run()
+                self.running[pid] = (outputs, jobs)
+                self.busy += jobs
+
+            pid, status = os.wait()
+            if pid not in self.running:
+                continue
+            outputs, jobs = self.running.pop(pid)
+            self.busy -= jobs
+            ok = os.WIFEXITED(status) and os.WEXITSTATUS(status) == 0
+            for outdir, callback in outputs:
+                result = os.path.join(outdir, "result.json")
+                if ok and os.path.exists(result):
+                    with open(result) as f:
+                        callback(json.load(f))
+                else:
+                    warn(
+                        "Simulation in %s failed, see %s"
+                        % (outdir, os.path.join(outdir, "simout.txt"))
+                    )
+                    self.num_failed += 1
+                    callback(None)
+
+
+class SaturationSearch:
+    """Bisection search for the saturation injection rate of one point.
+
+    The zero-load latency is measured at --saturation-min-rate. A rate is
+    saturated when its average packet latency exceeds
+    --saturation-latency-ratio times the zero-load latency. The search
+    keeps the highest unsaturated and the lowest saturated rate and
+    bisects until they are --saturation-tolerance apart."""
+
+    def __init__(self, swept, args, options, scheduler):
+        self.swept = swept
+        self.args = args
+        self.options = options
+        self.scheduler = scheduler
+        # Rates are only meaningful up to the tester's precision
+        self.resolution = max(
+            options.saturation_tolerance, 10**-args.precision
+        )
+        self.zero_load_latency = None
+        self.lo = None
+        self.hi = None
+        self.lo_row = None
+        self.num_simulations = 0
+        self.failed = False
+        self.probes = []
+
+    def start(self):
+        self.probe(self.options.saturation_min_rate)
+
+    def probe(self, rate):
+        args = copy.copy(self.args)
+        args.injectionrate = round(rate, self.args.precision)
+        self.num_simulations += 1
+        self.scheduler.submit(args, lambda stats: self.probed(args, stats))
+
+    def probed(self, args, stats):
+        if stats is None:
+            self.failed = True
+            return
+        row = make_row(self.swept, args, stats)
+        self.probes.append(row)
+        rate = args.injectionrate
+        latency = row["avg_latency"]
+
+        if self.zero_load_latency is None:
+            if not latency:
+                warn(
+                    "No packets delivered at the zero-load rate %g for %s"
+                    % (rate, self.swept)
+                )
+                self.failed = True
+                return
+            self.zero_load_latency = latency
+            self.lo, self.lo_row = rate, row
+            self.probe(self.options.saturation_max_rate)
+            return
+
+        limit = self.options.saturation_latency_ratio * self.zero_load_latency
+        # Packets that never arrive do not count towards the average
+        # latency, so a network that stops delivering is saturated too.
+        if (
+            latency > limit
+            or not row["packets_received"]
+            or row["exit_cause"] == SATURATED_CAUSE
+        ):
+            self.hi = rate
+        else:
+            self.lo, self.lo_row = rate, row
+
+        if self.hi is not None and self.hi - self.lo > self.resolution:
+            next_rate = round((self.lo + self.hi) / 2, self.args.precision)
+            if self.lo < next_rate < self.hi:
+                self.probe(next_rate)
+
+    def summary(self):
+        row = dict(self.swept)
+        row.update(
+            {
+                "zero_load_latency": self.zero_load_latency,
+                "saturated": int(self.hi is not None),
+                "saturation_rate": self.hi if self.hi is not None else "",
+                "max_unsaturated_rate": self.lo,
+                "max_unsaturated_throughput": (
+                    self.lo_row["throughput"] if self.lo_row else ""
+                ),
+                "num_simulations": self.num_simulations,
+            }
+        )
+        return row
+
+
+SEARCH_COLUMNS = [
+    "zero_load_latency",
+    "saturated",
+    "saturation_rate",
+    "max_unsaturated_rate",
+    "max_unsaturated_throughput",
+    "num_simulations",
+]
+
+
+def define_sweep_options(parser):
+    parser.add_argument(
+        "--sweep",
+        action="append",
+        default=[],
+        metavar="NAME[:NAME...]=V[:V...],...",
+        help="Option(s) to sweep and their values. May be repeated; the\
+                        sweeps are combined as a cross product.",
+    )
+    parser.add_argument(
+        "-j",
+        "--jobs",
+        type=int,
+        default=os.cpu_count(),
+        help="Number of points simulated at the same time.\
+                        Defaults to the number of host CPUs.",
+    )
+    parser.add_argument(
+        "--results",
+        type=str,
+        default="sweep_results.csv",
+        help="Results table, relative to the output directory.",
+    )
+    parser.add_argument(
+        "--split-results",
+        type=str,
+        default=None,
+        metavar="TEMPLATE",
+        help="Also write one table per distinct expansion of TEMPLATE,\
+                        e.g. '{synthetic}_results.csv'. Fields are the\
+                        swept option names with '-' replaced by '_'.",
+    )
+    parser.add_argument(
+        "--warm-once",
+        type=int,
+        default=0,
+        metavar="TICKS",
+        help="Warm up the network for this long once per group of\
+                        points that only differ in their injection rate,\
+                        then fork each point's simulation from the warm\
+                        state. In the same units as --sim-cycles.",
+    )
+    parser.add_argument(
+        "--saturation-search",
+        action="store_true",
+        help="Instead of simulating the given injection rate, search\
+                        the saturation injection rate of every point.",
+    )
+    parser.add_argument(
+        "--saturation-latency-ratio",
+        type=float,
+        default=3.0,
+        help="A rate is saturated when its average packet latency is\
+                        more than this many times the zero-load latency.",
+    )
+    parser.add_argument(
+        "--saturation-min-rate",
+        type=float,
+        default=0.01,
+        help="Injection rate at which the zero-load latency is measured.",
+    )
+    parser.add_argument(
+        "--saturation-max-rate",
+        type=float,
+        default=1.0,
+        help="Highest injection rate searched.",
+    )
+    parser.add_argument(
+        "--saturation-tolerance",
+        type=float,
+        default=0.01,
+        help="Stop the search when the saturation rate is known to\
+                        within this injection rate.",
+    )
+    parser.add_argument(
+        "--probe-results",
+        type=str,
+        default="saturation_probes.csv",
+        help="Table of every rate simulated by --saturation-search,\
+                        relative to the output directory.",
+    )
+
+
+parser = argparse.ArgumentParser(
+    description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+)
+garnet_synth_traffic.define_options(parser)
+define_sweep_options(parser)
+sweep_args = parser.parse_args()
+if sweep_args.jobs < 1:
+    fatal("--jobs must be at least 1")
+if sweep_args.saturation_search:
+    if not (
+        0
+        < sweep_args.saturation_min_rate
+        < sweep_args.saturation_max_rate
+        <= 1
+    ):
+        fatal("Need 0 < --saturation-min-rate < --saturation-max-rate <= 1")
+    if sweep_args.saturation_latency_ratio <= 1:
+        fatal("--saturation-latency-ratio must be greater than 1")
+if sweep_args.warm_once:
+    if sweep_args.saturation_search:
+        fatal("--warm-once does not support --saturation-search")
+    if sweep_args.trace:
+        fatal("--warm-once needs synthetic traffic, not a trace")
+    if sweep_args.warm_once < 0:
+        fatal("--warm-once must be positive")
+
+# The command line without the sweep options is the base of every point
+sweep_parser = argparse.ArgumentParser(add_help=False, allow_abbrev=False)
+define_sweep_options(sweep_parser)
+_, base_argv = sweep_parser.parse_known_args()
+if not sweep_args.route_cache_dir:
+    base_argv.append(
+        "--route-cache-dir=" + os.path.join(m5.options.outdir, "route_cache")
+    )
+
+axes = parse_sweeps(sweep_args.sweep)
+if sweep_args.saturation_search and any(
+    "injectionrate" in names for names, _ in axes
+):
+    fatal("--saturation-search chooses the injection rates itself")
+points = expand_points(parser, base_argv, axes)
+swept_columns = [n.replace("-", "_") for names, _ in axes for n in names]
+points = [
+    ({k.replace("-", "_"): v for k, v in swept.items()}, args)
+    for swept, args in points
+]
+
+sweep_dir = os.path.join(m5.options.outdir, "sweep")
+scheduler = Scheduler(sweep_args.jobs, sweep_dir)
+results = [None] * len(points)
+searches = []
+
+
+def store_result(index, swept, args):
+    def callback(stats):
+        if stats is not None:
+            results[index] = make_row(swept, args, stats)
+            print("Point %d done: %s" % (index, swept))
+
+    return callback
+
+
+if sweep_args.saturation_search:
+    print(
+        "Searching the saturation rate of %d points with up to %d jobs"
+        % (len(points), sweep_args.jobs)
+    )
+    for swept, args in points:
+        search = SaturationSearch(swept, args, sweep_args, scheduler)
+        searches.append(search)
+        search.start()
+elif sweep_args.warm_once:
+    # Points whose options only differ in the injection rate share
+    # their warmup, which injects at the lowest of their rates
+    groups = {}
+    for index, (swept, args) in enumerate(points):
+        options = dict(vars(args), injectionrate=None)
+        key = json.dumps(options, sort_keys=True, default=str)
+        groups.setdefault(key, []).append((index, swept, args))
+    print(
+        "Sweeping %d points in %d warm groups with up to %d jobs"
+        % (len(points), len(groups), sweep_args.jobs)
+    )
+    for group in groups.values():
+        group.sort(key=lambda member: member[2].injectionrate)
+        scheduler.submit_warm_group(
+            [(a, store_result(i, s, a)) for i, s, a in group],
+            sweep_args.warm_once,
+        )
+else:
+    print(
+        "Sweeping %d points with up to %d jobs"
+        % (len(points), sweep_args.jobs)
+    )
+    for index, (swept, args) in enumerate(points):
+        scheduler.submit(args, store_result(index, swept, args))
+
+scheduler.run()
+
+if sweep_args.saturation_search:
+    for search in searches:
+        if not search.failed:
+            print(
+                "%s: saturation rate %s after %d simulations"
+                % (
+                    search.swept,
+                    search.hi if search.hi is not None else "not reached",
+                    search.num_simulations,
+                )
+            )
+    rows = [s.summary() for s in searches if not s.failed]
+    columns = swept_columns + SEARCH_COLUMNS
+    probes = [r for s in searches for r in s.probes]
+    probe_columns = swept_columns + [
+        c for c in RESULT_COLUMNS if c not in swept_columns
+    ]
+    write_table(
+        os.path.join(m5.options.outdir, sweep_args.probe_results),
+        probe_columns,
+        sorted(probes, key=lambda r: r["injection_rate"]),
+    )
+    num_expected = len(searches)
+else:
+    rows = [r for r in results if r is not None]
+    columns = swept_columns + [
+        c for c in RESULT_COLUMNS if c not in swept_columns
+    ]
+    num_expected = len(points)
+
+write_table(os.path.join(m5.options.outdir, sweep_args.results), columns, rows)
+
+if sweep_args.split_results:
+    tables = {}
+    for row in rows:
+        name = sweep_args.split_results.format(**row)
+        tables.setdefault(name, []).append(row)
+    for name, table in tables.items():
+        write_table(os.path.join(m5.options.outdir, name), columns, table)
+
+print(
+    "Wrote %d of %d results to %s (%d simulations)"
+    % (
+        len(rows),
+        num_expected,
+        os.path.join(m5.options.outdir, sweep_args.results),
+        scheduler.num_points,
+    )
+)
+if len(rows) != num_expected or scheduler.num_failed:
+    sys.exit(1)
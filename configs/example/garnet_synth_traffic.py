@@ -29,185 +29,333 @@
 import m5
 from m5.objects import *
 from m5.defines import buildEnv
-from m5.util import addToPath
+from m5.util import addToPath, fatal
 import os, argparse, sys
 
 addToPath("../")
 
 from common import Options
 from ruby import Ruby
+from network import Network
 
 # Get paths we might need.  It's expected this file is in m5/configs/example.
 config_path = os.path.dirname(os.path.abspath(__file__))
 config_root = os.path.dirname(config_path)
 m5_root = os.path.dirname(config_root)
 
-parser = argparse.ArgumentParser()
-Options.addNoISAOptions(parser)
-
-parser.add_argument(
-    "--synthetic",
-    default="uniform_random",
-    choices=[
-        "uniform_random",
-        "tornado",
-        "bit_complement",
-        "bit_reverse",
-        "bit_rotation",
-        "neighbor",
-        "shuffle",
-        "transpose",
-    ],
-)
-
-parser.add_argument(
-    "-i",
-    "--injectionrate",
-    type=float,
-    default=0.1,
-    metavar="I",
-    help="Injection rate in packets per cycle per node. \
-                        Takes decimal value between 0 to 1 (eg. 0.225). \
-                        Number of digits after 0 depends upon --precision.",
-)
-
-parser.add_argument(
-    "--precision",
-    type=int,
-    default=3,
-    help="Number of digits of precision after decimal point\
-                        for injection rate",
-)
-
-parser.add_argument(
-    "--sim-cycles", type=int, default=1000, help="Number of simulation cycles"
-)
-
-parser.add_argument(
-    "--num-packets-max",
-    type=int,
-    default=-1,
-    help="Stop injecting after --num-packets-max.\
-                        Set to -1 to disable.",
-)
-
-parser.add_argument(
-    "--single-sender-id",
-    type=int,
-    default=-1,
-    help="Only inject from this sender.\
-                        Set to -1 to disable.",
-)
-
-parser.add_argument(
-    "--single-dest-id",
-    type=int,
-    default=-1,
-    help="Only send to this destination.\
-                        Set to -1 to disable.",
-)
-
-parser.add_argument(
-    "--inj-vnet",
-    type=int,
-    default=-1,
-    choices=[-1, 0, 1, 2],
-    help="Only inject in this vnet (0, 1 or 2).\
-                        0 and 1 are 1-flit, 2 is 5-flit.\
-                        Set to -1 to inject randomly in all vnets.",
-)
-
-parser.add_argument(
-    "--adaptive-tie-breaking",
-    type=str,
-    default="x_first",
-    choices=["x_first", "uniform", "z_first"],
-    help="Tie-breaking strategy for adaptive routing when congestion scores are equal.\
-                        x_first: prefer X dimension (default), \
-                        uniform: randomly select among tied directions, \
-                        z_first: prefer Z dimension.",
-)
-
-parser.add_argument(
-    "--escape-vcs",
-    type=int,
-    default=1,
-    help="Number of escape VCs per virtual network for adaptive routing algorithm 4 (TORUS3D_ADAPTIVE).\
-                        Must be <= vcs-per-vnet. Default is 1.",
-)
-
-parser.add_argument(
-    "--distance-coefficient",
-    type=float,
-    default=0.0,
-    help="Distance preference coefficient for adaptive routing. \
-                        Negative: prefer short remaining distances (conservative, DOR-like). \
-                        Positive: prefer long remaining distances (load balancing). \
-                        Zero: pure congestion-based routing. Range: -1.0 to 1.0.",
-)
 
-#
-# Add the ruby specific and protocol specific options
-#
-Ruby.define_options(parser)
+def define_options(parser):
+    """Add the synthetic traffic and Ruby options to parser."""
+    Options.addNoISAOptions(parser)
+
+    parser.add_argument(
+        "--synthetic",
+        default="uniform_random",
+        choices=[
+            "uniform_random",
+            "tornado",
+            "bit_complement",
+            "bit_reverse",
+            "bit_rotation",
+            "neighbor",
+            "shuffle",
+            "transpose",
+        ],
+    )
+
+    parser.add_argument(
+        "-i",
+        "--injectionrate",
+        type=float,
+        default=0.1,
+        metavar="I",
+        help="Injection rate in packets per cycle per node. \
+                            Takes decimal value between 0 to 1 (eg. 0.225). \
+                            Number of digits after 0 depends upon --precision.",
+    )
+
+    parser.add_argument(
+        "--injection-mode",
+        default="per_cycle",
+        choices=["per_cycle", "geometric"],
+        help="per_cycle: every tester wakes up each cycle and draws\
+                            whether to inject (default). geometric: \
+                            same injection process, but each tester only \
+                            wakes up in the cycles it injects in.",
+    )
+
+    parser.add_argument(
+        "--precision",
+        type=int,
+        default=3,
+        help="Number of digits of precision after decimal point\
+                            for injection rate",
+    )
+
+    parser.add_argument(
+        "--sim-cycles",
+        type=int,
+        default=1000,
+        help="Number of simulation cycles",
+    )
 
-args = parser.parse_args()
+    parser.add_argument(
+        "--num-packets-max",
+        type=int,
+        default=-1,
+        help="Stop injecting after --num-packets-max.\
+                            Set to -1 to disable.",
+    )
 
-cpus = [
-    GarnetSyntheticTraffic(
-        num_packets_max=args.num_packets_max,
-        single_sender=args.single_sender_id,
-        single_dest=args.single_dest_id,
-        sim_cycles=args.sim_cycles,
-        traffic_type=args.synthetic,
-        inj_rate=args.injectionrate,
-        inj_vnet=args.inj_vnet,
-        precision=args.precision,
-        num_dest=args.num_dirs,
+    parser.add_argument(
+        "--single-sender-id",
+        type=int,
+        default=-1,
+        help="Only inject from this sender.\
+                            Set to -1 to disable.",
     )
-    for i in range(args.num_cpus)
-]
 
-# create the desired simulated system
-system = System(cpu=cpus, mem_ranges=[AddrRange(args.mem_size)])
+    parser.add_argument(
+        "--single-dest-id",
+        type=int,
+        default=-1,
+        help="Only send to this destination.\
+                            Set to -1 to disable.",
+    )
+
+    parser.add_argument(
+        "--inj-vnet",
+        type=int,
+        default=-1,
+        choices=[-1, 0, 1, 2],
+        help="Only inject in this vnet (0, 1 or 2).\
+                            0 and 1 are 1-flit, 2 is 5-flit.\
+                            Set to -1 to inject randomly in all vnets.",
+    )
 
+    parser.add_argument(
+        "--direct-injection",
+        action="store_true",
+        help="Inject packets straight into the network interfaces \
+                            instead of through the sequencers and the \
+                            coherence protocol. --num-packets-max, \
+                            --single-sender-id and --single-dest-id \
+                            are not supported.",
+    )
 
-# Create a top-level voltage domain and clock domain
-system.voltage_domain = VoltageDomain(voltage=args.sys_voltage)
+    parser.add_argument(
+        "--packet-sizes",
+        type=str,
+        default=None,
+        help="Comma separated packet size in bytes of each vnet \
+                            for --direct-injection. Default is the \
+                            control size for vnets 0 and 1 and the \
+                            data size for vnet 2.",
+    )
 
-system.clk_domain = SrcClockDomain(
-    clock=args.sys_clock, voltage_domain=system.voltage_domain
-)
+    parser.add_argument(
+        "--trace",
+        type=str,
+        default=None,
+        help="Replay this binary packet trace instead of synthetic \
+                            traffic, injecting straight into the network \
+                            interfaces. See util/encode_garnet_trace.py.",
+    )
 
-Ruby.create_system(args, False, system)
+    parser.add_argument(
+        "--trace-time-scale",
+        type=float,
+        default=1.0,
+        help="Factor applied to the trace times. Below 1 compresses \
+                            the trace; 0 only keeps the dependencies.",
+    )
 
-# Create a seperate clock domain for Ruby
-system.ruby.clk_domain = SrcClockDomain(
-    clock=args.ruby_clock, voltage_domain=system.voltage_domain
-)
+    parser.add_argument(
+        "--trace-window",
+        type=int,
+        default=65536,
+        help="Maximum number of trace packets read but not yet \
+                            delivered.",
+    )
+
+    parser.add_argument(
+        "--adaptive-tie-breaking",
+        type=str,
+        default="x_first",
+        choices=["x_first", "uniform", "z_first"],
+        help="Tie-breaking strategy for adaptive routing when congestion scores are equal.\
+                            x_first: prefer X dimension (default), \
+                            uniform: randomly select among tied directions, \
+                            z_first: prefer Z dimension.",
+    )
+
+    parser.add_argument(
+        "--escape-vcs",
+        type=int,
+        default=1,
+        help="Number of escape VCs per virtual network for adaptive routing algorithm 4 (TORUS3D_ADAPTIVE).\
+                            Must be <= vcs-per-vnet. Default is 1.",
+    )
+
+    parser.add_argument(
+        "--distance-coefficient",
+        type=float,
+        default=0.0,
+        help="Distance preference coefficient for adaptive routing. \
+                            Negative: prefer short remaining distances (conservative, DOR-like). \
+                            Positive: prefer long remaining distances (load balancing). \
+                            Zero: pure congestion-based routing. Range: -1.0 to 1.0.",
+    )
+
+    parser.add_argument(
+        "--congestion-sensing",
+        type=str,
+        default="instantaneous",
+        choices=["instantaneous", "ewma"],
+        help="Congestion metric for adaptive routing.\
+                            instantaneous: current output VC occupancy (default), \
+                            ewma: moving average of the output VC occupancy.",
+    )
+
+    parser.add_argument(
+        "--congestion-ewma-window",
+        type=int,
+        default=8,
+        help="Window, in cycles, of the moving average used by \
+                            --congestion-sensing=ewma. Default is 8.",
+    )
+
+    parser.add_argument(
+        "--event-queue-backend",
+        default="linked_list",
+        choices=["linked_list", "calendar"],
+        help="Structure keeping the pending events in order. Both \
+                            service events in the same order; calendar is \
+                            faster with many distinct event times.",
+    )
 
-i = 0
-for ruby_port in system.ruby._cpu_ports:
     #
-    # Tie the cpu test ports to the ruby cpu port
+    # Add the ruby specific and protocol specific options
     #
-    cpus[i].test = ruby_port.in_ports
-    i += 1
+    Ruby.define_options(parser)
+
+
+def create_root(args):
+    """Build the tester system described by args and return its Root."""
+
+    if args.direct_injection or args.trace:
+        mode = "--trace" if args.trace else "--direct-injection"
+        if args.num_packets_max >= 0:
+            fatal("--num-packets-max is not supported with %s", mode)
+        if args.single_sender_id >= 0:
+            fatal("--single-sender-id is not supported with %s", mode)
+        if args.single_dest_id >= 0:
+            fatal("--single-dest-id is not supported with %s", mode)
+        cpus = []
+    else:
+        cpus = [
+            GarnetSyntheticTraffic(
+                num_packets_max=args.num_packets_max,
+                single_sender=args.single_sender_id,
+                single_dest=args.single_dest_id,
+                sim_cycles=args.sim_cycles,
+                traffic_type=args.synthetic,
+                inj_rate=args.injectionrate,
+                inj_mode=args.injection_mode,
+                inj_vnet=args.inj_vnet,
+                precision=args.precision,
+                num_dest=args.num_dirs,
+            )
+            for i in range(args.num_cpus)
+        ]
+
+    # create the desired simulated system
+    system = System(cpu=cpus, mem_ranges=[AddrRange(args.mem_size)])
+
+
+    # Create a top-level voltage domain and clock domain
+    system.voltage_domain = VoltageDomain(voltage=args.sys_voltage)
+
+    system.clk_domain = SrcClockDomain(
+        clock=args.sys_clock, voltage_domain=system.voltage_domain
+    )
+
+    Ruby.create_system(args, False, system)
+
+    if args.trace:
+        system.injector = GarnetTraceReplay(
+            network=system.ruby.network,
+            trace_file=args.trace,
+            time_scale=args.trace_time_scale,
+            window=args.trace_window,
+        )
+    elif args.direct_injection:
+        if args.packet_sizes:
+            packet_sizes = [int(s) for s in args.packet_sizes.split(",")]
+        else:
+            # Garnet_standalone control and data message sizes
+            control_size = 8
+            packet_sizes = [
+                control_size,
+                control_size,
+                args.cacheline_size + control_size,
+            ]
+        system.injector = GarnetDirectInjector(
+            network=system.ruby.network,
+            num_dest=args.num_dirs,
+            sim_cycles=args.sim_cycles,
+            traffic_type=args.synthetic,
+            inj_rate=args.injectionrate,
+            inj_vnet=args.inj_vnet,
+            packet_sizes=packet_sizes,
+            precision=args.precision,
+        )
+
+    # Optionally spread the network over several event queues
+    sim_quantum = Network.partition_network(args, system.ruby.network)
+
+    # Create a seperate clock domain for Ruby
+    system.ruby.clk_domain = SrcClockDomain(
+        clock=args.ruby_clock, voltage_domain=system.voltage_domain
+    )
+
+    i = 0
+    for ruby_port in system.ruby._cpu_ports[: len(cpus)]:
+        #
+        # Tie the cpu test ports to the ruby cpu port
+        #
+        cpus[i].test = ruby_port.in_ports
+        if sim_quantum:
+            # Keep each tester on the event queue of its sequencer
+            cpus[i].eventq_index = ruby_port.eventq_index
+        i += 1
+
+    root = Root(full_system=False, system=system)
+    root.system.mem_mode = "timing"
+    root.event_queue_backend = args.event_queue_backend
+    if sim_quantum:
+        root.sim_quantum = sim_quantum
+    return root
+
+
+if __name__ == "__m5_main__":
+    parser = argparse.ArgumentParser()
+    define_options(parser)
+    args = parser.parse_args()
 
-# -----------------------
-# run simulation
-# -----------------------
+    # -----------------------
+    # run simulation
+    # -----------------------
 
-root = Root(full_system=False, system=system)
-root.system.mem_mode = "timing"
+    root = create_root(args)
 
-# Not much point in this being higher than the L1 latency
-m5.ticks.setGlobalFrequency("2GHz")
+    # Not much point in this being higher than the L1 latency
+    m5.ticks.setGlobalFrequency("2GHz")
 
-# instantiate configuration
-m5.instantiate()
+    # instantiate configuration
+    m5.instantiate()
 
-# simulate until program terminates
-exit_event = m5.simulate(args.abs_max_tick)
+    # simulate until program terminates
+    exit_event = m5.simulate(args.abs_max_tick)
 
-print("Exiting @ tick", m5.curTick(), "because", exit_event.getCause())
+    print("Exiting @ tick", m5.curTick(), "because", exit_event.getCause())
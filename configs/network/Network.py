@@ -131,6 +131,85 @@ def define_options(parser):
         default=50000,
         help="network-level deadlock threshold.",
     )
+    parser.add_argument(
+        "--garnet-partitions",
+        action="store",
+        type=int,
+        default=1,
+        help="""number of event queues (host threads) to spread
+            the garnet routers over. Routers are split into blocks
+            of consecutive ids, i.e. z-planes of a 3D torus.""",
+    )
+    parser.add_argument(
+        "--route-cache-dir",
+        action="store",
+        type=str,
+        default="",
+        help="""directory caching the routing tables computed for
+            each topology. Empty disables the cache.""",
+    )
+    parser.add_argument(
+        "--steady-state-window",
+        action="store",
+        type=int,
+        default=0,
+        help="""cycles per window of the garnet steady state
+            detection. When set, the stats are reset once injection
+            and ejection rates match, and the simulation exits once
+            the average packet latency converged or the network
+            saturated. 0 disables it.""",
+    )
+    parser.add_argument(
+        "--steady-state-ci",
+        action="store",
+        type=float,
+        default=0.02,
+        help="""relative half-width of the 95%% confidence interval
+            of the average packet latency at which a steady state
+            simulation exits.""",
+    )
+    parser.add_argument(
+        "--saturation-windows",
+        action="store",
+        type=int,
+        default=10,
+        help="""consecutive steady state windows of growing packets
+            in flight after which the network is saturated.""",
+    )
+    parser.add_argument(
+        "--lookahead-routing",
+        action="store_true",
+        default=False,
+        help="""compute the route of a packet one hop ahead, during
+            switch allocation at the previous garnet router, so that
+            route computation leaves the router pipeline.""",
+    )
+    parser.add_argument(
+        "--garnet-pair-latency-file",
+        action="store",
+        type=str,
+        default="",
+        help="""file, in the output directory, receiving the garnet
+            packet latency percentiles of every pair of routers.
+            Empty disables the per-pair histograms.""",
+    )
+    parser.add_argument(
+        "--garnet-telemetry-interval",
+        action="store",
+        type=int,
+        default=0,
+        help="""cycles between two samples of the per-link, per-VC
+            and per-router activity of garnet. 0 disables the
+            sampler. See util/garnet_telemetry.py.""",
+    )
+    parser.add_argument(
+        "--garnet-telemetry-samples",
+        action="store",
+        type=int,
+        default=4096,
+        help="""number of samples the garnet telemetry keeps. Only
+            the newest ones are written out.""",
+    )
     parser.add_argument(
         "--simple-physical-channels",
         action="store_true",
@@ -183,6 +262,8 @@ def create_network(options, ruby):
 
 def init_network(options, network, InterfaceClass):
 
+    network.route_cache_dir = options.route_cache_dir
+
     if options.network == "garnet":
         network.num_rows = options.mesh_rows
         network.torus_x = options.torus_x
@@ -192,6 +273,13 @@ def init_network(options, network, InterfaceClass):
         network.ni_flit_size = options.link_width_bits / 8
         network.routing_algorithm = options.routing_algorithm
         network.garnet_deadlock_threshold = options.garnet_deadlock_threshold
+        network.steady_state_window = options.steady_state_window
+        network.steady_state_ci = options.steady_state_ci
+        network.saturation_windows = options.saturation_windows
+        network.pair_latency_file = options.garnet_pair_latency_file
+        network.lookahead_routing = options.lookahead_routing
+        network.telemetry_interval = options.garnet_telemetry_interval
+        network.telemetry_samples = options.garnet_telemetry_samples
 
         # Set adaptive tie-breaking strategy if available
         if hasattr(options, "adaptive_tie_breaking"):
@@ -205,6 +293,12 @@ def init_network(options, network, InterfaceClass):
         if hasattr(options, "distance_coefficient"):
             network.distance_coefficient = options.distance_coefficient
 
+        # Set congestion sensing mode for adaptive routing if available
+        if hasattr(options, "congestion_sensing"):
+            network.congestion_sensing = options.congestion_sensing
+        if hasattr(options, "congestion_ewma_window"):
+            network.congestion_ewma_window = options.congestion_ewma_window
+
         # Create Bridges and connect them to the corresponding links
         for intLink in network.int_links:
             intLink.src_net_bridge = NetworkBridge(
@@ -314,3 +408,67 @@ def init_network(options, network, InterfaceClass):
         assert options.network == "garnet"
         network.enable_fault_model = True
         network.fault_model = FaultModel()
+
+
+def partition_network(options, network):
+    """Spread a garnet network over options.garnet_partitions event
+    queues, so that it is simulated by as many host threads.
+
+    Each router goes with its network interfaces, external links and
+    attached controllers. Links between partitions belong to the side
+    that drives them: the source router for the network link and the
+    destination router for the credit link. Their latency is the
+    lookahead between the partitions, so the simulation quantum is the
+    smallest such latency; it is returned as a latency string to be
+    assigned to Root.sim_quantum, or None if the network is not
+    partitioned. Must be called after the network has been created.
+    """
+
+    num_partitions = getattr(options, "garnet_partitions", 1)
+    if num_partitions <= 1:
+        return None
+    if options.network != "garnet":
+        fatal("--garnet-partitions requires --network=garnet")
+
+    num_routers = len(network.routers)
+    if num_partitions > num_routers:
+        fatal(
+            "Cannot split %d routers into %d partitions"
+            % (num_routers, num_partitions)
+        )
+
+    # Consecutive router ids are kept together, which for a 3D torus
+    # means whole z-planes as long as the partitions divide torus_z
+    partition = {}
+    for router in network.routers:
+        part = int(router.router_id) * num_partitions // num_routers
+        partition[int(router.router_id)] = part
+        router.eventq_index = part
+
+    for ni, ext_link in zip(network.netifs, network.ext_links):
+        part = partition[int(ext_link.int_node.router_id)]
+        ni.eventq_index = part
+        for obj in ext_link.descendants():
+            obj.eventq_index = part
+        for obj in ext_link.ext_node.descendants():
+            obj.eventq_index = part
+
+    min_latency = None
+    for int_link in network.int_links:
+        src = partition[int(int_link.src_node.router_id)]
+        dst = partition[int(int_link.dst_node.router_id)]
+        for obj in int_link.descendants():
+            obj.eventq_index = src
+        int_link.credit_link.eventq_index = dst
+        if src != dst:
+            latency = int(int_link.latency)
+            if min_latency is None or latency < min_latency:
+                min_latency = latency
+
+    if min_latency is None:
+        return None
+
+    # Round down to whole picoseconds: the quantum must not exceed the
+    # latency of any link between partitions
+    period_ps = 1e12 / m5.util.convert.toFrequency(options.ruby_clock)
+    return "%dps" % int(min_latency * period_ps)
@@ -6,6 +6,15 @@ from m5.objects import *
 from common import FileSystemConfig
 from topologies.BaseTopology import SimpleTopology
 
+# (positive, negative) port direction names for the X, Y and Z dimensions.
+# Garnet translates these names to integer port directions once, when the
+# router ports are created, so they must match the names it knows about.
+TORUS3D_PORT_DIRECTIONS = [
+    ("East", "West"),
+    ("North", "South"),
+    ("Up", "Down"),
+]
+
 
 class Torus3D(SimpleTopology):
     description = "Torus3D"
@@ -105,113 +114,56 @@ class Torus3D(SimpleTopology):
         def coord_to_id(x, y, z):
             return z * self.dim_x * self.dim_y + y * self.dim_x + x
 
-        # Create bidirectional links in X dimension (East-West)
-        for z in range(self.dim_z):
-            for y in range(self.dim_y):
-                for x in range(self.dim_x):
-                    curr_id = coord_to_id(x, y, z)
-                    next_x = (x + 1) % self.dim_x  # Torus wrapping
-                    next_id = coord_to_id(next_x, y, z)
-
-                    # East direction link
-                    int_links.append(
-                        IntLink(
-                            link_id=link_count,
-                            src_node=routers[curr_id],
-                            dst_node=routers[next_id],
-                            src_outport="East",
-                            dst_inport="West",
-                            latency=link_latency,
-                            weight=1,
-                        )
-                    )
-                    link_count += 1
-
-                    # West direction link (reverse)
-                    int_links.append(
-                        IntLink(
-                            link_id=link_count,
-                            src_node=routers[next_id],
-                            dst_node=routers[curr_id],
-                            src_outport="West",
-                            dst_inport="East",
-                            latency=link_latency,
-                            weight=1,
-                        )
-                    )
-                    link_count += 1
-
-        # Create bidirectional links in Y dimension (North-South)
-        for z in range(self.dim_z):
-            for x in range(self.dim_x):
-                for y in range(self.dim_y):
-                    curr_id = coord_to_id(x, y, z)
-                    next_y = (y + 1) % self.dim_y  # Torus wrapping
-                    next_id = coord_to_id(x, next_y, z)
-
-                    # North direction link
-                    int_links.append(
-                        IntLink(
-                            link_id=link_count,
-                            src_node=routers[curr_id],
-                            dst_node=routers[next_id],
-                            src_outport="North",
-                            dst_inport="South",
-                            latency=link_latency,
-                            weight=1,
+        dims = [self.dim_x, self.dim_y, self.dim_z]
+
+        # Create bidirectional ring links along one dimension.
+        # The two other dimensions are iterated outer-most first, in
+        # Z, Y, X order, which fixes the link ids.
+        def connect_dimension(dim):
+            nonlocal link_count
+            positive, negative = TORUS3D_PORT_DIRECTIONS[dim]
+            outer, inner = [d for d in (2, 1, 0) if d != dim]
+            coord = [0, 0, 0]
+            for coord[outer] in range(dims[outer]):
+                for coord[inner] in range(dims[inner]):
+                    for pos in range(dims[dim]):
+                        coord[dim] = pos
+                        curr_id = coord_to_id(*coord)
+                        coord[dim] = (pos + 1) % dims[dim]  # Torus wrapping
+                        next_id = coord_to_id(*coord)
+
+                        # Positive direction link
+                        int_links.append(
+                            IntLink(
+                                link_id=link_count,
+                                src_node=routers[curr_id],
+                                dst_node=routers[next_id],
+                                src_outport=positive,
+                                dst_inport=negative,
+                                latency=link_latency,
+                                weight=1,
+                            )
                         )
-                    )
-                    link_count += 1
-
-                    # South direction link (reverse)
-                    int_links.append(
-                        IntLink(
-                            link_id=link_count,
-                            src_node=routers[next_id],
-                            dst_node=routers[curr_id],
-                            src_outport="South",
-                            dst_inport="North",
-                            latency=link_latency,
-                            weight=1,
+                        link_count += 1
+
+                        # Negative direction link (reverse)
+                        int_links.append(
+                            IntLink(
+                                link_id=link_count,
+                                src_node=routers[next_id],
+                                dst_node=routers[curr_id],
+                                src_outport=negative,
+                                dst_inport=positive,
+                                latency=link_latency,
+                                weight=1,
+                            )
                         )
-                    )
-                    link_count += 1
-
-        # Create bidirectional links in Z dimension (Up-Down)
-        for y in range(self.dim_y):
-            for x in range(self.dim_x):
-                for z in range(self.dim_z):
-                    curr_id = coord_to_id(x, y, z)
-                    next_z = (z + 1) % self.dim_z  # Torus wrapping
-                    next_id = coord_to_id(x, y, next_z)
-
-                    # Up direction link
-                    int_links.append(
-                        IntLink(
-                            link_id=link_count,
-                            src_node=routers[curr_id],
-                            dst_node=routers[next_id],
-                            src_outport="Up",
-                            dst_inport="Down",
-                            latency=link_latency,
-                            weight=1,
-                        )
-                    )
-                    link_count += 1
-
-                    # Down direction link (reverse)
-                    int_links.append(
-                        IntLink(
-                            link_id=link_count,
-                            src_node=routers[next_id],
-                            dst_node=routers[curr_id],
-                            src_outport="Down",
-                            dst_inport="Up",
-                            latency=link_latency,
-                            weight=1,
-                        )
-                    )
-                    link_count += 1
+                        link_count += 1
+
+        # X dimension (East-West), Y dimension (North-South),
+        # Z dimension (Up-Down)
+        for dim in range(3):
+            connect_dimension(dim)
 
         network.int_links = int_links
 
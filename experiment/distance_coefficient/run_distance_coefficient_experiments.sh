@@ -20,109 +20,33 @@ pattern="bit_reverse"
 # Negative: prefer short remaining distances (conservative, DOR-like)
 # Zero: pure congestion-based routing
 # Positive: prefer long remaining distances (load balancing)
-distance_coefficients=(-4 -2 0 2 4)
+distance_coefficients="-4,-2,0,2,4"
 
 # injection rates from 0.01 to 1.0
-injection_rates=(0.01 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0)
+injection_rates="0.01,0.1,0.2,0.3,0.4,0.5,0.6,0.7,0.8,0.9,1.0"
 
-# Function to extract statistics
-extract_stats() {
-    local rate=$1
-
-    # Extract statistics
-    packets_received=$(grep "packets_received::total" m5out/stats.txt | awk '{print $2}')
-    packets_injected=$(grep "packets_injected::total" m5out/stats.txt | awk '{print $2}')
-    avg_packet_latency=$(grep "average_packet_latency" m5out/stats.txt | awk '{print $2}')
-    avg_hops=$(grep "average_hops" m5out/stats.txt | awk '{print $2}')
-
-    # Extract network latency and queuing latency
-    avg_packet_network_latency=$(grep "average_packet_network_latency" m5out/stats.txt | awk '{print $2}')
-    avg_packet_queueing_latency=$(grep "average_packet_queueing_latency" m5out/stats.txt | awk '{print $2}')
-
-    # Try alternative names if not found
-    if [ -z "$avg_packet_network_latency" ] || [ "$avg_packet_network_latency" = "(Unspecified)" ]; then
-        avg_packet_network_latency=$(grep "avg_packet_network_latency" m5out/stats.txt | awk '{print $2}')
-    fi
-    if [ -z "$avg_packet_queueing_latency" ] || [ "$avg_packet_queueing_latency" = "(Unspecified)" ]; then
-        avg_packet_queueing_latency=$(grep "avg_packet_queueing_latency" m5out/stats.txt | awk '{print $2}')
-    fi
-
-    # Handle (Unspecified) values
-    [ "$packets_received" = "(Unspecified)" ] && packets_received="0"
-    [ "$packets_injected" = "(Unspecified)" ] && packets_injected="0"
-    [ "$avg_packet_latency" = "(Unspecified)" ] && avg_packet_latency="0"
-    [ "$avg_hops" = "(Unspecified)" ] && avg_hops="0"
-    [ "$avg_packet_network_latency" = "(Unspecified)" ] && avg_packet_network_latency="0"
-    [ "$avg_packet_queueing_latency" = "(Unspecified)" ] && avg_packet_queueing_latency="0"
-
-    # Calculate throughput
-    if [ ! -z "$packets_received" ] && [ "$packets_received" != "0" ]; then
-        throughput=$(python3 -c "print(f'{$packets_received / 10000:.6f}')")
-        per_node_throughput=$(python3 -c "print(f'{($packets_received / 10000) / 64:.6f}')")
-    else
-        throughput="0.000000"
-        per_node_throughput="0.000000"
-    fi
-
-    echo "$rate,$throughput,$per_node_throughput,$avg_packet_latency,$avg_hops,$avg_packet_network_latency,$avg_packet_queueing_latency,$packets_received,$packets_injected"
-}
-
-# Main experiment loop - only bit_reverse pattern
 echo ""
 echo "Testing traffic pattern: $pattern"
 echo "=================================================="
 
-for dist_coeff in "${distance_coefficients[@]}"; do
-    echo ""
-    if [ $dist_coeff -lt 0 ]; then
-        echo "Distance coefficient: $dist_coeff (conservative, DOR-like preference)"
-    elif [ $dist_coeff -eq 0 ]; then
-        echo "Distance coefficient: $dist_coeff (pure congestion-based routing)"
-    else
-        echo "Distance coefficient: $dist_coeff (load balancing preference)"
-    fi
-    echo "-----------------------------------"
-
-    # Create result file for this combination
-    result_file="$results_dir/${pattern}_distcoeff${dist_coeff}_results.csv"
-    > $result_file  # Clear file
-
-    # Add CSV header
-    echo "injection_rate,throughput,per_node_throughput,avg_latency,avg_hops,network_latency,queueing_latency,packets_received,packets_injected" > $result_file
-
-    for rate in "${injection_rates[@]}"; do
-        echo "  Injection Rate: $rate"
-
-        # Run gem5 simulation
-        ./build/NULL/gem5.opt configs/example/garnet_synth_traffic.py \
-            --network=garnet --num-cpus=64 --num-dirs=64 \
-            --topology=Torus3D --torus-x=4 --torus-y=4 --torus-z=4 \
-            --routing-algorithm=4 --synthetic=$pattern \
-            --sim-cycles=10000 --injectionrate=$rate \
-            --inj-vnet=2 --adaptive-tie-breaking=x_first \
-            --vcs-per-vnet=4 \
-            --escape-vcs=1 \
-            --distance-coefficient=$dist_coeff \
-            > /dev/null 2>&1
-
-        # Check if simulation succeeded
-        if [ $? -eq 0 ]; then
-            # Extract and save statistics
-            stats_line=$(extract_stats "$rate")
-            echo "$stats_line" >> $result_file
-
-            # Display progress
-            throughput=$(echo "$stats_line" | cut -d',' -f2)
-            latency=$(echo "$stats_line" | cut -d',' -f4)
-            echo "    Throughput: $throughput, Latency: $latency"
-        else
-            echo "    FAILED: Rate $rate"
-            echo "$rate,FAILED,FAILED,FAILED,FAILED,FAILED,FAILED,FAILED,FAILED" >> $result_file
-        fi
-    done
-
-    echo "Results saved to: $result_file"
-done
+# All points run in parallel worker processes of a single gem5 invocation.
+# The per-point outputs are kept in $results_dir/sweep/<index>.
+./build/NULL/gem5.opt -d $results_dir configs/example/garnet_sweep.py \
+    --network=garnet --num-cpus=64 --num-dirs=64 \
+    --topology=Torus3D --torus-x=4 --torus-y=4 --torus-z=4 \
+    --routing-algorithm=4 --synthetic=$pattern \
+    --sim-cycles=10000 \
+    --inj-vnet=2 --adaptive-tie-breaking=x_first \
+    --vcs-per-vnet=4 \
+    --escape-vcs=1 \
+    --sweep distance-coefficient=$distance_coefficients \
+    --sweep injectionrate=$injection_rates \
+    --results=${pattern}_distance_coefficient_results.csv \
+    --split-results="${pattern}_distcoeff{distance_coefficient}_results.csv"
+
+if [ $? -ne 0 ]; then
+    echo "Warning: some simulations failed, see $results_dir/sweep/*/simout.txt"
+fi
 
 echo ""
 echo "========================================"
@@ -133,7 +57,7 @@ echo "Generated files:"
 ls -la $results_dir/*.csv
 echo ""
 echo "Files generated:"
-for dist_coeff in "${distance_coefficients[@]}"; do
+for dist_coeff in ${distance_coefficients//,/ }; do
     echo "  ${pattern}_distcoeff${dist_coeff}_results.csv"
 done
 echo ""
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * Copyright (c) 2016 Georgia Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/testers/garnet_synthetic_traffic/GarnetDirectInjector.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/GarnetSyntheticTraffic.hh"
+#include "mem/ruby/network/garnet/GarnetNetwork.hh"
+#include "mem/ruby/network/garnet/NetworkInterface.hh"
+#include "mem/ruby/network/garnet/SyntheticMessage.hh"
+#include "sim/core.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+using namespace ruby;
+using namespace ruby::garnet;
+
+GarnetDirectInjector::GarnetDirectInjector(const Params &p)
+    : ClockedObject(p),
+      network(p.network),
+      injectEvent([this]{ inject(); }, "GarnetDirectInjector inject"),
+      sourceType(string_to_MachineType(p.source_type)),
+      destType(string_to_MachineType(p.dest_type)),
+      numSources(MachineType_base_count(sourceType)),
+      numDestinations(p.num_dest),
+      traffic(GarnetSyntheticTraffic::trafficTypeFromName(p.traffic_type)),
+      injProb(GarnetSyntheticTraffic::injectionProbability(p.inj_rate,
+                                                           p.precision)),
+      precision(p.precision),
+      injVnet(p.inj_vnet),
+      simCycles(p.sim_cycles),
+      packetSizes(p.packet_sizes),
+      stats(this)
+{
+    fatal_if(traffic == NUM_TRAFFIC_PATTERNS_,
+             "%s: unknown traffic type %s\n", name(), p.traffic_type);
+    fatal_if(numDestinations < 1 ||
+             numDestinations > MachineType_base_count(destType),
+             "%s: %d destinations of type %s requested but %d exist\n",
+             name(), numDestinations, p.dest_type,
+             MachineType_base_count(destType));
+
+    if (injVnet >= 0) {
+        fatal_if(injVnet >= packetSizes.size() || packetSizes[injVnet] <= 0,
+                 "%s: no packet size for vnet %d\n", name(), injVnet);
+        injVnets.push_back(injVnet);
+    } else {
+        for (int vnet = 0; vnet < packetSizes.size(); vnet++) {
+            if (packetSizes[vnet] > 0)
+                injVnets.push_back(vnet);
+        }
+        fatal_if(injVnets.empty(), "%s: no vnet has a packet size\n",
+                 name());
+    }
+
+    for (int dest = 0; dest < numDestinations; dest++) {
+        destNodes.push_back(MachineType_base_number(destType) + dest);
+        destNetDests.emplace_back();
+        destNetDests.back().add((MachineID) {destType, (NodeID) dest});
+    }
+
+    rng = &random_mt;
+    if (numMainEventQueues > 1) {
+        ownRng = std::make_unique<Random>(random_mt.random<uint32_t>());
+        rng = ownRng.get();
+    }
+}
+
+void
+GarnetDirectInjector::startup()
+{
+    // The injector enqueues into buffers drained on every event queue
+    fatal_if(numMainEventQueues > 1,
+             "%s: direct injection needs a single event queue\n", name());
+
+    // Every interface may eject packets, not only the sources
+    for (int ni = 0; ni < network->getNumNIs(); ni++)
+        network->getNetworkInterface(ni)->setSyntheticTraffic();
+
+    sourceBuffers.resize(numSources);
+    for (int source = 0; source < numSources; source++) {
+        NodeID global_id = MachineType_base_number(sourceType) + source;
+        NetworkInterface *ni =
+            network->getNetworkInterface(network->getLocalNodeID(global_id));
+        sourceBuffers[source].resize(packetSizes.size(), nullptr);
+        for (int vnet : injVnets) {
+            MessageBuffer *buffer = ni->getInNode(vnet);
+            fatal_if(!buffer, "%s: source %d has no buffer for vnet %d\n",
+                     name(), source, vnet);
+            sourceBuffers[source][vnet] = buffer;
+        }
+    }
+
+    drawInjections();
+    schedule(injectEvent, clockEdge());
+}
+
+void
+GarnetDirectInjector::setInjectionRate(double inj_rate)
+{
+    injProb = GarnetSyntheticTraffic::injectionProbability(inj_rate,
+                                                           precision);
+
+    // Injections are memoryless, so the pending gaps can be drawn again
+    drawInjections();
+    if (injectEvent.scheduled())
+        reschedule(injectEvent, clockEdge());
+    else
+        schedule(injectEvent, clockEdge());
+}
+
+void
+GarnetDirectInjector::setSimCycles(Tick sim_cycles)
+{
+    simCycles = sim_cycles;
+    if (injectEvent.scheduled())
+        reschedule(injectEvent, clockEdge());
+    else
+        schedule(injectEvent, clockEdge());
+}
+
+void
+GarnetDirectInjector::drawInjections()
+{
+    injections = decltype(injections)();
+    for (int source = 0; source < numSources; source++) {
+        injections.emplace(curCycle() +
+            GarnetSyntheticTraffic::geometricGap(injProb, *rng), source);
+    }
+}
+
+void
+GarnetDirectInjector::inject()
+{
+    while (!injections.empty() && injections.top().first <= curCycle()) {
+        int source = injections.top().second;
+        injections.pop();
+        injectPacket(source);
+        injections.emplace(curCycle() + Cycles(1) +
+            GarnetSyntheticTraffic::geometricGap(injProb, *rng), source);
+    }
+
+    if (curTick() >= simCycles) {
+        exitSimLoop("Network Tester completed simCycles");
+        return;
+    }
+
+    // Wake up at the next injection, or when the simulation is over
+    Cycles next(divCeil(simCycles - curTick(), clockPeriod()));
+    if (!injections.empty())
+        next = std::min(next, Cycles(injections.top().first - curCycle()));
+    schedule(injectEvent, clockEdge(std::max(next, Cycles(1))));
+}
+
+void
+GarnetDirectInjector::injectPacket(int source)
+{
+    unsigned dest = GarnetSyntheticTraffic::trafficDestination(
+        traffic, source, numDestinations, *rng);
+    panic_if(dest >= numDestinations,
+             "%s: traffic pattern sends %d to %d of %d destinations\n",
+             name(), source, dest, numDestinations);
+
+    int vnet = injVnets.size() == 1 ? injVnets[0] :
+        injVnets[rng->random<int>(0, injVnets.size() - 1)];
+    MessageBuffer *buffer = sourceBuffers[source][vnet];
+    Tick now = clockEdge();
+    if (!buffer->areNSlotsAvailable(1, now)) {
+        DPRINTF(GarnetSyntheticTraffic, "Source %d vnet %d full, "
+                "dropping packet to %d\n", source, vnet, dest);
+        stats.packetsDropped++;
+        return;
+    }
+
+    DPRINTF(GarnetSyntheticTraffic, "Source %d injecting %d bytes to %d "
+            "on vnet %d\n", source, packetSizes[vnet], dest, vnet);
+    buffer->enqueue(std::make_shared<SyntheticMessage>(
+                        now, destNodes[dest], &destNetDests[dest],
+                        packetSizes[vnet]),
+                    now, cyclesToTicks(Cycles(1)));
+    stats.packetsInjected++;
+}
+
+GarnetDirectInjector::DirectInjectorStats::DirectInjectorStats(
+    statistics::Group *parent)
+      : statistics::Group(parent),
+      ADD_STAT(packetsInjected, statistics::units::Count::get(),
+               "number of packets enqueued in the protocol buffers"),
+      ADD_STAT(packetsDropped, statistics::units::Count::get(),
+               "number of packets dropped because the protocol buffer "
+               "was full")
+{
+}
+
+} // namespace gem5
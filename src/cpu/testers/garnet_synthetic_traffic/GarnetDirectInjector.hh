@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * Copyright (c) 2016 Georgia Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __CPU_GARNET_DIRECT_INJECTOR_HH__
+#define __CPU_GARNET_DIRECT_INJECTOR_HH__
+
+#include <functional>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "base/random.hh"
+#include "base/statistics.hh"
+#include "cpu/testers/garnet_synthetic_traffic/GarnetSyntheticTraffic.hh"
+#include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+#include "mem/ruby/protocol/MachineType.hh"
+#include "params/GarnetDirectInjector.hh"
+#include "sim/clocked_object.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+namespace garnet
+{
+class GarnetNetwork;
+} // namespace garnet
+} // namespace ruby
+
+/**
+ * Injects synthetic packets straight into the network interfaces of a
+ * Garnet network, bypassing the sequencers and the coherence protocol.
+ * Every node of the source machine type injects with geometric gaps
+ * between packets, to destinations picked with the traffic patterns of
+ * GarnetSyntheticTraffic. The network interfaces drop the packets when
+ * they are ejected, so the controllers of the protocol stay idle.
+ */
+class GarnetDirectInjector : public ClockedObject
+{
+  public:
+    typedef GarnetDirectInjectorParams Params;
+    GarnetDirectInjector(const Params &p);
+
+    void startup() override;
+
+    // Change the injection rate and the end of the simulation, e.g. in
+    // the runs forked from a warmed-up simulation
+    void setInjectionRate(double inj_rate);
+    void setSimCycles(Tick sim_cycles);
+
+  private:
+    // Inject the packets of all the sources due this cycle
+    void inject();
+    void injectPacket(int source);
+    void drawInjections();
+
+    ruby::garnet::GarnetNetwork *network;
+    EventFunctionWrapper injectEvent;
+
+    ruby::MachineType sourceType;
+    ruby::MachineType destType;
+    int numSources;
+    int numDestinations;
+
+    TrafficType traffic;
+    double injProb;
+    int precision;
+    int injVnet;
+    Tick simCycles;
+
+    // Packet size in bytes of each vnet, and the vnets injected in when
+    // no single vnet is given
+    std::vector<int> packetSizes;
+    std::vector<int> injVnets;
+
+    // Protocol buffer feeding each vnet of each source
+    std::vector<std::vector<ruby::MessageBuffer *>> sourceBuffers;
+
+    // Global node id and NetDest of each destination, shared by all
+    // the packets sent to it
+    std::vector<ruby::NodeID> destNodes;
+    std::vector<ruby::NetDest> destNetDests;
+
+    // Next injection cycle of each source, earliest first
+    typedef std::pair<Cycles, int> Injection;
+    std::priority_queue<Injection, std::vector<Injection>,
+                        std::greater<Injection>> injections;
+
+    std::unique_ptr<Random> ownRng;
+    Random *rng;
+
+    struct DirectInjectorStats : public statistics::Group
+    {
+        DirectInjectorStats(statistics::Group *parent);
+        statistics::Scalar packetsInjected;
+        // Packets not injected because the protocol buffer was full
+        statistics::Scalar packetsDropped;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_GARNET_DIRECT_INJECTOR_HH__
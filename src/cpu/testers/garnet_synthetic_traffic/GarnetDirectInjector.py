@@ -0,0 +1,66 @@
+# Copyright (c) 2026 The AI_X-Lab Authors
+# Copyright (c) 2016 Georgia Institute of Technology
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.ClockedObject import ClockedObject
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import PyBindMethod
+
+
+class GarnetDirectInjector(ClockedObject):
+    type = "GarnetDirectInjector"
+    cxx_header = "cpu/testers/garnet_synthetic_traffic/GarnetDirectInjector.hh"
+    cxx_class = "gem5::GarnetDirectInjector"
+    cxx_exports = [
+        PyBindMethod("setInjectionRate"),
+        PyBindMethod("setSimCycles"),
+    ]
+
+    network = Param.GarnetNetwork("Garnet network to inject into")
+    source_type = Param.String(
+        "L1Cache", "Machine type of the nodes that inject"
+    )
+    dest_type = Param.String(
+        "Directory", "Machine type of the destination nodes"
+    )
+    num_dest = Param.Int(1, "Number of Destinations")
+    sim_cycles = Param.Int(1000, "Number of simulation cycles")
+    traffic_type = Param.String("uniform_random", "Traffic type")
+    inj_rate = Param.Float(0.1, "Packet injection rate")
+    inj_vnet = Param.Int(
+        -1,
+        "Vnet to inject in. Default is to inject in all the vnets with \
+                             a packet size",
+    )
+    packet_sizes = VectorParam.Int(
+        [8, 8, 72], "Packet size in bytes of each vnet, 0 to not inject"
+    )
+    precision = Param.Int(
+        3,
+        "Number of digits of precision \
+                              after decimal point",
+    )
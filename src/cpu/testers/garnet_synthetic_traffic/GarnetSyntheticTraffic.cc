@@ -30,10 +30,12 @@
 
 #include <cmath>
 #include <iomanip>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/random.hh"
 #include "base/statistics.hh"
@@ -90,6 +92,7 @@ GarnetSyntheticTraffic::GarnetSyntheticTraffic(const Params &p)
       injRate(p.inj_rate),
       injVnet(p.inj_vnet),
       precision(p.precision),
+      geometricInjection(false),
       responseLimit(p.response_limit),
       requestorId(p.system->getRequestorId(this))
 {
@@ -97,11 +100,18 @@ GarnetSyntheticTraffic::GarnetSyntheticTraffic(const Params &p)
     noResponseCycles = 0;
     schedule(tickEvent, 0);
 
-    initTrafficType();
-    if (trafficStringToEnum.count(trafficType) == 0) {
-        fatal("Unknown Traffic Type: %s!\n", traffic);
+    traffic = trafficTypeFromName(trafficType);
+    if (traffic == NUM_TRAFFIC_PATTERNS_) {
+        fatal("Unknown Traffic Type: %s!\n", trafficType);
+    }
+
+    if (p.inj_mode == "geometric") {
+        geometricInjection = true;
+    } else if (p.inj_mode != "per_cycle") {
+        fatal("Unknown injection mode: %s!\n", p.inj_mode);
     }
-    traffic = trafficStringToEnum[trafficType];
+
+    injProb = injectionProbability(injRate, precision);
 
     id = TESTER_NETWORK++;
     DPRINTF(GarnetSyntheticTraffic,"Config Created: Name = %s , and id = %d\n",
@@ -121,6 +131,19 @@ void
 GarnetSyntheticTraffic::init()
 {
     numPacketsSent = 0;
+
+    // Testers may run in parallel threads; seed a generator per tester
+    // from random_mt while still single-threaded
+    rng = &random_mt;
+    if (numMainEventQueues > 1) {
+        ownRng.reset(new Random(random_mt.random<uint32_t>()));
+        rng = ownRng.get();
+    }
+
+    if (geometricInjection) {
+        progressCycle = curCycle();
+        nextInjection = curCycle() + sampleInjectionGap();
+    }
 }
 
 
@@ -134,13 +157,61 @@ GarnetSyntheticTraffic::completeRequest(PacketPtr pkt)
 
     assert(pkt->isResponse());
     noResponseCycles = 0;
+    progressCycle = curCycle();
     delete pkt;
 }
 
 
+bool
+GarnetSyntheticTraffic::senderEnabled() const
+{
+    if (numPacketsMax >= 0 && numPacketsSent >= numPacketsMax)
+        return false;
+
+    if (singleSender >= 0 && id != singleSender)
+        return false;
+
+    return true;
+}
+
+void
+GarnetSyntheticTraffic::setInjectionRate(double inj_rate)
+{
+    injRate = inj_rate;
+    injProb = injectionProbability(injRate, precision);
+
+    // Injections are memoryless, so the pending gap can be drawn again
+    if (geometricInjection)
+        nextInjection = curCycle() + sampleInjectionGap();
+    wakeUp();
+}
+
+void
+GarnetSyntheticTraffic::setSimCycles(Tick sim_cycles)
+{
+    simCycles = sim_cycles;
+    wakeUp();
+}
+
+void
+GarnetSyntheticTraffic::wakeUp()
+{
+    // The geometric mode may be sleeping until the old end or
+    // injection, and the per-cycle mode stops after the end
+    if (geometricInjection && tickEvent.scheduled())
+        reschedule(tickEvent, clockEdge());
+    else if (!tickEvent.scheduled())
+        schedule(tickEvent, clockEdge(Cycles(1)));
+}
+
 void
 GarnetSyntheticTraffic::tick()
 {
+    if (geometricInjection) {
+        tickGeometric();
+        return;
+    }
+
     if (++noResponseCycles >= responseLimit) {
         fatal("%s deadlocked at cycle %d\n", name(), curTick());
     }
@@ -151,25 +222,15 @@ GarnetSyntheticTraffic::tick()
     // - send pkt if this number is < injRate*(10^precision)
     bool sendAllowedThisCycle;
     double injRange = pow((double) 10, (double) precision);
-    unsigned trySending = random_mt.random<unsigned>(0, (int) injRange);
+    unsigned trySending = rng->random<unsigned>(0, (int) injRange);
     if (trySending < injRate*injRange)
         sendAllowedThisCycle = true;
     else
         sendAllowedThisCycle = false;
 
     // always generatePkt unless fixedPkts or singleSender is enabled
-    if (sendAllowedThisCycle) {
-        bool senderEnable = true;
-
-        if (numPacketsMax >= 0 && numPacketsSent >= numPacketsMax)
-            senderEnable = false;
-
-        if (singleSender >= 0 && id != singleSender)
-            senderEnable = false;
-
-        if (senderEnable)
-            generatePkt();
-    }
+    if (sendAllowedThisCycle && senderEnabled())
+        generatePkt();
 
     // Schedule wakeup
     if (curTick() >= simCycles)
@@ -180,23 +241,19 @@ GarnetSyntheticTraffic::tick()
     }
 }
 
-void
-GarnetSyntheticTraffic::generatePkt()
+unsigned
+GarnetSyntheticTraffic::trafficDestination(TrafficType traffic, int source,
+                                           int num_destinations, Random &rng)
 {
-    int num_destinations = numDestinations;
     int radix = (int) sqrt(num_destinations);
-    unsigned destination = id;
+    unsigned destination = source;
     int dest_x = -1;
     int dest_y = -1;
-    int source = id;
-    int src_x = id%radix;
-    int src_y = id/radix;
+    int src_x = source%radix;
+    int src_y = source/radix;
 
-    if (singleDest >= 0)
-    {
-        destination = singleDest;
-    } else if (traffic == UNIFORM_RANDOM_) {
-        destination = random_mt.random<unsigned>(0, num_destinations - 1);
+    if (traffic == UNIFORM_RANDOM_) {
+        destination = rng.random<unsigned>(0, num_destinations - 1);
     } else if (traffic == BIT_COMPLEMENT_) {
         dest_x = radix - src_x - 1;
         dest_y = radix - src_y - 1;
@@ -241,6 +298,85 @@ GarnetSyntheticTraffic::generatePkt()
         fatal("Unknown Traffic Type: %s!\n", traffic);
     }
 
+    return destination;
+}
+
+double
+GarnetSyntheticTraffic::injectionProbability(double inj_rate, int precision)
+{
+    // tick() injects when a draw from [0, 10^precision] is below
+    // inj_rate*10^precision; this is the probability of that
+    double injRange = pow((double) 10, (double) precision);
+    double num_hits = inj_rate > 0 ? ceil(inj_rate * injRange) : 0;
+    return std::min(num_hits, (double) (int) injRange + 1) /
+           ((int) injRange + 1);
+}
+
+Cycles
+GarnetSyntheticTraffic::geometricGap(double prob, Random &rng)
+{
+    // Number of failed attempts before the first success of independent
+    // per-cycle attempts that succeed with prob
+    if (prob <= 0)
+        return Cycles(MaxTick / 2);
+    if (prob >= 1)
+        return Cycles(0);
+
+    double u = 1.0 - rng.random<double>();
+    double gap = floor(log(u) / log1p(-prob));
+    return Cycles(static_cast<uint64_t>(
+        std::min(gap, (double) (MaxTick / 2))));
+}
+
+Cycles
+GarnetSyntheticTraffic::sampleInjectionGap()
+{
+    // A tester that can no longer send sleeps until the end of the
+    // simulation
+    if (!senderEnabled())
+        return Cycles(MaxTick / 2);
+    return geometricGap(injProb, *rng);
+}
+
+void
+GarnetSyntheticTraffic::tickGeometric()
+{
+    noResponseCycles += curCycle() - progressCycle;
+    progressCycle = curCycle();
+    if (noResponseCycles >= responseLimit) {
+        fatal("%s deadlocked at cycle %d\n", name(), curTick());
+    }
+
+    // Same injections as drawing every cycle, but only the cycles that
+    // inject (and the last one) are simulated
+    if (curCycle() >= nextInjection) {
+        if (senderEnabled())
+            generatePkt();
+        nextInjection = curCycle() + Cycles(1) + sampleInjectionGap();
+    }
+
+    if (curTick() >= simCycles) {
+        exitSimLoop("Network Tester completed simCycles");
+        return;
+    }
+
+    // Wake up for the next injection or the first cycle that tick()
+    // would have exited in, whichever comes first
+    Cycles to_exit(divCeil(simCycles - curTick(), clockPeriod()));
+    Cycles to_injection = nextInjection - curCycle();
+    if (!tickEvent.scheduled())
+        schedule(tickEvent, clockEdge(std::min(to_exit, to_injection)));
+}
+
+void
+GarnetSyntheticTraffic::generatePkt()
+{
+    unsigned destination;
+    if (singleDest >= 0)
+        destination = singleDest;
+    else
+        destination = trafficDestination(traffic, id, numDestinations, *rng);
+
     // The source of the packets is a cache.
     // The destination of the packets is a directory.
     // The destination bits are embedded in the address after byte-offset.
@@ -285,7 +421,7 @@ GarnetSyntheticTraffic::generatePkt()
     if (injReqType < 0 || injReqType > 2)
     {
         // randomly inject in any vnet
-        injReqType = random_mt.random(0, 2);
+        injReqType = rng->random(0, 2);
     }
 
     if (injReqType == 0) {
@@ -323,17 +459,24 @@ GarnetSyntheticTraffic::generatePkt()
     sendPkt(pkt);
 }
 
-void
-GarnetSyntheticTraffic::initTrafficType()
+TrafficType
+GarnetSyntheticTraffic::trafficTypeFromName(const std::string &name)
 {
-    trafficStringToEnum["bit_complement"] = BIT_COMPLEMENT_;
-    trafficStringToEnum["bit_reverse"] = BIT_REVERSE_;
-    trafficStringToEnum["bit_rotation"] = BIT_ROTATION_;
-    trafficStringToEnum["neighbor"] = NEIGHBOR_;
-    trafficStringToEnum["shuffle"] = SHUFFLE_;
-    trafficStringToEnum["tornado"] = TORNADO_;
-    trafficStringToEnum["transpose"] = TRANSPOSE_;
-    trafficStringToEnum["uniform_random"] = UNIFORM_RANDOM_;
+    static const std::map<std::string, TrafficType> trafficStringToEnum = {
+        {"bit_complement", BIT_COMPLEMENT_},
+        {"bit_reverse", BIT_REVERSE_},
+        {"bit_rotation", BIT_ROTATION_},
+        {"neighbor", NEIGHBOR_},
+        {"shuffle", SHUFFLE_},
+        {"tornado", TORNADO_},
+        {"transpose", TRANSPOSE_},
+        {"uniform_random", UNIFORM_RANDOM_},
+    };
+
+    auto it = trafficStringToEnum.find(name);
+    if (it == trafficStringToEnum.end())
+        return NUM_TRAFFIC_PATTERNS_;
+    return it->second;
 }
 
 void
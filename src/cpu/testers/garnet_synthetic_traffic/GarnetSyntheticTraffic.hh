@@ -29,8 +29,11 @@
 #ifndef __CPU_GARNET_SYNTHETIC_TRAFFIC_HH__
 #define __CPU_GARNET_SYNTHETIC_TRAFFIC_HH__
 
+#include <memory>
 #include <set>
+#include <string>
 
+#include "base/random.hh"
 #include "base/statistics.hh"
 #include "mem/port.hh"
 #include "params/GarnetSyntheticTraffic.hh"
@@ -65,6 +68,13 @@ class GarnetSyntheticTraffic : public ClockedObject
     // main simulation loop (one cycle)
     void tick();
 
+    /**
+     * Change the injection rate and the end of the simulation, e.g. in
+     * the runs forked from a warmed-up simulation.
+     */
+    void setInjectionRate(double inj_rate);
+    void setSimCycles(Tick sim_cycles);
+
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
@@ -74,6 +84,31 @@ class GarnetSyntheticTraffic : public ClockedObject
      */
     void printAddr(Addr a);
 
+    /**
+     * Traffic pattern of a traffic_type name, or NUM_TRAFFIC_PATTERNS_
+     * if the name is unknown.
+     */
+    static TrafficType trafficTypeFromName(const std::string &name);
+
+    /**
+     * Destination of a packet sent by source under a traffic pattern.
+     * Sources and destinations are numbered from 0 to num_destinations-1.
+     */
+    static unsigned trafficDestination(TrafficType traffic, int source,
+                                       int num_destinations, Random &rng);
+
+    /**
+     * Probability that the per-cycle injection draw of tick() succeeds
+     * for an injection rate given with precision decimal digits.
+     */
+    static double injectionProbability(double inj_rate, int precision);
+
+    /**
+     * Number of cycles without an injection before the next one, for
+     * independent per-cycle attempts that succeed with prob.
+     */
+    static Cycles geometricGap(double prob, Random &rng);
+
   protected:
     EventFunctionWrapper tickEvent;
 
@@ -112,8 +147,6 @@ class GarnetSyntheticTraffic : public ClockedObject
     unsigned size;
     int id;
 
-    std::map<std::string, TrafficType> trafficStringToEnum;
-
     unsigned blockSizeBits;
 
     Tick noResponseCycles;
@@ -131,15 +164,35 @@ class GarnetSyntheticTraffic : public ClockedObject
     int injVnet;
     int precision;
 
+    // Probability of an injection attempt in any one cycle
+    double injProb;
+
+    // Geometric injection mode: sleep until the next injection instead
+    // of drawing every cycle. nextInjection is the cycle of the next
+    // injection; progressCycle the cycle up to which noResponseCycles
+    // has been counted.
+    bool geometricInjection;
+    Cycles nextInjection;
+    Cycles progressCycle;
+
     const Cycles responseLimit;
 
     RequestorID requestorId;
 
+    // random_mt, or a generator of this tester's own when the simulation
+    // runs several event queues in parallel
+    Random *rng;
+    std::unique_ptr<Random> ownRng;
+
     void completeRequest(PacketPtr pkt);
 
+    bool senderEnabled() const;
+    void wakeUp();
+    void tickGeometric();
+    Cycles sampleInjectionGap();
+
     void generatePkt();
     void sendPkt(PacketPtr pkt);
-    void initTrafficType();
 
     void doRetry();
 
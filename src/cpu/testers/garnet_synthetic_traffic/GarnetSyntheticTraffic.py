@@ -27,6 +27,7 @@
 from m5.objects.ClockedObject import ClockedObject
 from m5.params import *
 from m5.proxy import *
+from m5.SimObject import PyBindMethod
 
 
 class GarnetSyntheticTraffic(ClockedObject):
@@ -35,6 +36,10 @@ class GarnetSyntheticTraffic(ClockedObject):
         "cpu/testers/garnet_synthetic_traffic/GarnetSyntheticTraffic.hh"
     )
     cxx_class = "gem5::GarnetSyntheticTraffic"
+    cxx_exports = [
+        PyBindMethod("setInjectionRate"),
+        PyBindMethod("setSimCycles"),
+    ]
 
     block_offset = Param.Int(6, "block offset in bits")
     num_dest = Param.Int(1, "Number of Destinations")
@@ -57,6 +62,13 @@ class GarnetSyntheticTraffic(ClockedObject):
     )
     traffic_type = Param.String("uniform_random", "Traffic type")
     inj_rate = Param.Float(0.1, "Packet injection rate")
+    inj_mode = Param.String(
+        "per_cycle",
+        "How injections are scheduled. per_cycle wakes up every cycle \
+                            and draws whether to inject; geometric draws \
+                            the number of cycles to the next injection \
+                            and only wakes up then",
+    )
     inj_vnet = Param.Int(
         -1,
         "Vnet to inject in. \
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * Copyright (c) 2016 Georgia Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/testers/garnet_synthetic_traffic/GarnetTraceReplay.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/GarnetSyntheticTraffic.hh"
+#include "mem/ruby/network/garnet/GarnetNetwork.hh"
+#include "mem/ruby/network/garnet/NetworkInterface.hh"
+#include "mem/ruby/protocol/MachineType.hh"
+#include "sim/core.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+using namespace ruby;
+using namespace ruby::garnet;
+
+namespace
+{
+
+// Consumed trace pages are dropped from memory in chunks of this size
+constexpr size_t releaseChunk = 64 * 1024 * 1024;
+
+MachineID
+machineIDOfNode(NodeID global_id)
+{
+    for (int m = 0; m < MachineType_NUM; m++) {
+        MachineType type = (MachineType) m;
+        if (global_id < MachineType_base_number(type) +
+                        MachineType_base_count(type)) {
+            return {type, global_id - MachineType_base_number(type)};
+        }
+    }
+    panic("Node %d is not a valid global node id\n", global_id);
+}
+
+} // anonymous namespace
+
+GarnetTraceReplay::GarnetTraceReplay(const Params &p)
+    : ClockedObject(p),
+      network(p.network),
+      replayEvent([this]{ replay(); }, "GarnetTraceReplay replay"),
+      timeScale(p.time_scale),
+      window(p.window),
+      fd(-1), traceStart(nullptr), traceSize(0), traceOffset(0),
+      releasedOffset(0), numRecords(0), nextId(0)
+{
+    fatal_if(timeScale < 0, "%s: negative time scale %f\n", name(),
+             timeScale);
+    fatal_if(window < 1, "%s: the window must hold a packet\n", name());
+
+    mapTrace(p.trace_file);
+}
+
+GarnetTraceReplay::~GarnetTraceReplay()
+{
+    if (traceStart)
+        munmap(const_cast<uint8_t *>(traceStart), traceSize);
+    if (fd >= 0)
+        close(fd);
+}
+
+void
+GarnetTraceReplay::mapTrace(const std::string &file_name)
+{
+    fd = open(file_name.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "%s: cannot open trace %s: %s\n", name(), file_name,
+             strerror(errno));
+
+    struct stat st;
+    fatal_if(fstat(fd, &st) < 0, "%s: cannot stat trace %s: %s\n", name(),
+             file_name, strerror(errno));
+    traceSize = st.st_size;
+    fatal_if(traceSize < sizeof(GarnetTraceHeader),
+             "%s: trace %s is too short\n", name(), file_name);
+
+    void *start = mmap(nullptr, traceSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    fatal_if(start == MAP_FAILED, "%s: cannot map trace %s: %s\n", name(),
+             file_name, strerror(errno));
+    traceStart = static_cast<const uint8_t *>(start);
+    madvise(start, traceSize, MADV_SEQUENTIAL);
+
+    GarnetTraceHeader header;
+    memcpy(&header, traceStart, sizeof(header));
+    fatal_if(memcmp(header.magic, GarnetTraceHeader::MAGIC,
+                    sizeof(header.magic)) != 0,
+             "%s: %s is not a Garnet trace\n", name(), file_name);
+    fatal_if(header.version != GarnetTraceHeader::VERSION,
+             "%s: trace %s has version %d, expected %d\n", name(),
+             file_name, header.version, GarnetTraceHeader::VERSION);
+    numRecords = header.numRecords;
+    traceOffset = sizeof(header);
+}
+
+void
+GarnetTraceReplay::startup()
+{
+    // The replay enqueues into buffers drained on every event queue
+    fatal_if(numMainEventQueues > 1,
+             "%s: trace replay needs a single event queue\n", name());
+
+    for (int ni = 0; ni < network->getNumNIs(); ni++)
+        network->getNetworkInterface(ni)->setSyntheticTraffic();
+
+    NodeID num_nodes = MachineType_base_number(MachineType_NUM);
+    destNetDests.resize(num_nodes);
+    for (NodeID node = 0; node < num_nodes; node++)
+        destNetDests[node].add(machineIDOfNode(node));
+
+    startCycle = curCycle();
+    readTrace();
+    schedule(replayEvent, clockEdge());
+}
+
+void
+GarnetTraceReplay::readTrace()
+{
+    NodeID num_nodes = destNetDests.size();
+
+    while (nextId < numRecords && pending.size() < window) {
+        fatal_if(traceOffset + sizeof(GarnetTraceRecord) > traceSize,
+                 "%s: trace ends in record %d\n", name(), nextId);
+        GarnetTraceRecord record;
+        memcpy(&record, traceStart + traceOffset, sizeof(record));
+        traceOffset += sizeof(record);
+
+        uint64_t id = nextId++;
+        fatal_if(record.src >= num_nodes || record.dst >= num_nodes,
+                 "%s: packet %d goes from node %d to node %d but there "
+                 "are %d nodes\n", name(), id, record.src, record.dst,
+                 num_nodes);
+        // An empty packet would be split into no flits, never be
+        // delivered and never release its dependents
+        fatal_if(record.size == 0, "%s: packet %d has no bytes\n",
+                 name(), id);
+        fatal_if(record.vnet >= network->getNumberOfVirtualNetworks(),
+                 "%s: packet %d uses vnet %d but there are %d vnets\n",
+                 name(), id, record.vnet,
+                 network->getNumberOfVirtualNetworks());
+
+        PendingPacket &pkt = pending[id];
+        pkt.release = startCycle +
+            Cycles(static_cast<uint64_t>(std::ceil(record.time * timeScale)));
+        pkt.src = record.src;
+        pkt.dst = record.dst;
+        pkt.size = record.size;
+        pkt.vnet = record.vnet;
+        pkt.unmetDeps = 0;
+
+        size_t deps_size = record.numDeps * sizeof(uint64_t);
+        fatal_if(traceOffset + deps_size > traceSize,
+                 "%s: trace ends in the dependencies of packet %d\n",
+                 name(), id);
+        for (int i = 0; i < record.numDeps; i++) {
+            uint64_t dep;
+            memcpy(&dep, traceStart + traceOffset + i * sizeof(dep),
+                   sizeof(dep));
+            fatal_if(dep >= id, "%s: packet %d depends on later packet "
+                     "%d\n", name(), id, dep);
+            // Packets no longer pending were delivered
+            auto it = pending.find(dep);
+            if (it != pending.end()) {
+                it->second.dependents.push_back(id);
+                pkt.unmetDeps++;
+            }
+        }
+        traceOffset += deps_size;
+
+        if (pkt.unmetDeps == 0)
+            markReady(id, pkt);
+    }
+
+    // Drop the pages already read from memory, so that the trace does
+    // not have to fit in it
+    if (traceOffset - releasedOffset >= releaseChunk) {
+        size_t page_size = sysconf(_SC_PAGESIZE);
+        size_t end = traceOffset / page_size * page_size;
+        madvise(const_cast<uint8_t *>(traceStart) + releasedOffset,
+                end - releasedOffset, MADV_DONTNEED);
+        releasedOffset = end;
+    }
+}
+
+void
+GarnetTraceReplay::markReady(uint64_t id, const PendingPacket &pkt)
+{
+    ready.emplace(std::max(pkt.release, curCycle()), id);
+}
+
+void
+GarnetTraceReplay::replay()
+{
+    std::vector<ReadyPacket> retry;
+    while (!ready.empty() && ready.top().first <= curCycle()) {
+        uint64_t id = ready.top().second;
+        ready.pop();
+        if (!injectPacket(id, pending.at(id)))
+            retry.emplace_back(curCycle() + Cycles(1), id);
+    }
+    for (auto &pkt : retry)
+        ready.push(pkt);
+
+    readTrace();
+
+    if (nextId == numRecords && pending.empty()) {
+        exitSimLoop("Trace replay completed");
+        return;
+    }
+    scheduleReplay();
+}
+
+bool
+GarnetTraceReplay::injectPacket(uint64_t id, const PendingPacket &pkt)
+{
+    NetworkInterface *ni =
+        network->getNetworkInterface(network->getLocalNodeID(pkt.src));
+    MessageBuffer *buffer = ni->getInNode(pkt.vnet);
+    fatal_if(!buffer, "%s: node %d has no buffer for vnet %d\n", name(),
+             pkt.src, pkt.vnet);
+
+    Tick now = clockEdge();
+    if (!buffer->areNSlotsAvailable(1, now))
+        return false;
+
+    DPRINTF(GarnetSyntheticTraffic, "Packet %d: node %d injecting %d "
+            "bytes to node %d on vnet %d\n", id, pkt.src, pkt.size,
+            pkt.dst, pkt.vnet);
+    buffer->enqueue(std::make_shared<SyntheticMessage>(
+                        now, pkt.dst, &destNetDests[pkt.dst], pkt.size,
+                        this, id),
+                    now, cyclesToTicks(Cycles(1)));
+    return true;
+}
+
+void
+GarnetTraceReplay::packetDelivered(uint64_t id)
+{
+    DPRINTF(GarnetSyntheticTraffic, "Packet %d delivered\n", id);
+
+    auto it = pending.find(id);
+    assert(it != pending.end());
+    for (uint64_t dependent : it->second.dependents) {
+        PendingPacket &pkt = pending.at(dependent);
+        if (--pkt.unmetDeps == 0)
+            markReady(dependent, pkt);
+    }
+    pending.erase(it);
+
+    // Refill the window and wake up for the newly ready packets, or to
+    // end the replay after the last delivery
+    readTrace();
+    if (nextId == numRecords && pending.empty()) {
+        if (!replayEvent.scheduled())
+            schedule(replayEvent, clockEdge());
+    } else {
+        scheduleReplay();
+    }
+}
+
+void
+GarnetTraceReplay::scheduleReplay()
+{
+    if (ready.empty())
+        return;
+
+    Cycles next = ready.top().first;
+    Tick when = clockEdge(next > curCycle() ? next - curCycle() : Cycles(0));
+    if (!replayEvent.scheduled())
+        schedule(replayEvent, when);
+    else if (when < replayEvent.when())
+        reschedule(replayEvent, when);
+}
+
+} // namespace gem5
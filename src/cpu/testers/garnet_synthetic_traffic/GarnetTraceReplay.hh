@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * Copyright (c) 2016 Georgia Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __CPU_GARNET_TRACE_REPLAY_HH__
+#define __CPU_GARNET_TRACE_REPLAY_HH__
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+#include "mem/ruby/network/garnet/SyntheticMessage.hh"
+#include "params/GarnetTraceReplay.hh"
+#include "sim/clocked_object.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+namespace garnet
+{
+class GarnetNetwork;
+} // namespace garnet
+} // namespace ruby
+
+/**
+ * Layout of a Garnet packet trace. The file starts with a header and is
+ * followed by one record per packet, in nondecreasing time order. Each
+ * record is followed by the ids of the packets it depends on. The id of
+ * a packet is the index of its record and a packet may only depend on
+ * earlier packets. All fields are little endian.
+ */
+struct GarnetTraceHeader
+{
+    static constexpr char MAGIC[8] = {'G', 'N', 'T', 'R', 'A', 'C', 'E',
+                                      '\0'};
+    static constexpr uint32_t VERSION = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t numRecords;
+};
+
+struct GarnetTraceRecord
+{
+    // Injection cycle
+    uint64_t time;
+    // Global node ids of the source and destination interfaces
+    uint32_t src;
+    uint32_t dst;
+    // Packet size in bytes
+    uint32_t size;
+    uint16_t vnet;
+    uint16_t numDeps;
+};
+
+static_assert(sizeof(GarnetTraceHeader) == 24, "unexpected trace header");
+static_assert(sizeof(GarnetTraceRecord) == 24, "unexpected trace record");
+
+/**
+ * Replays a Garnet packet trace by injecting its packets straight into
+ * the network interfaces, like GarnetDirectInjector. The trace is mapped
+ * in memory and streamed: at most a window of packets that are read but
+ * not yet delivered is kept. A packet is injected at its trace time,
+ * scaled by time_scale, and not before the packets it depends on are
+ * delivered.
+ */
+class GarnetTraceReplay : public ClockedObject,
+                          public ruby::garnet::SyntheticTrafficClient
+{
+  public:
+    typedef GarnetTraceReplayParams Params;
+    GarnetTraceReplay(const Params &p);
+    ~GarnetTraceReplay();
+
+    void startup() override;
+
+    void packetDelivered(uint64_t id) override;
+
+  private:
+    struct PendingPacket
+    {
+        Cycles release;
+        uint32_t src;
+        uint32_t dst;
+        uint32_t size;
+        uint16_t vnet;
+        // Dependencies not delivered yet
+        unsigned unmetDeps;
+        // Packets waiting for this one to be delivered
+        std::vector<uint64_t> dependents;
+    };
+
+    void mapTrace(const std::string &file_name);
+    // Read records until the window is full or the trace is over
+    void readTrace();
+    void markReady(uint64_t id, const PendingPacket &pkt);
+    // Inject the ready packets due this cycle
+    void replay();
+    bool injectPacket(uint64_t id, const PendingPacket &pkt);
+    void scheduleReplay();
+
+    ruby::garnet::GarnetNetwork *network;
+    EventFunctionWrapper replayEvent;
+
+    double timeScale;
+    uint64_t window;
+    Cycles startCycle;
+
+    // Mapped trace and the part of it read so far
+    int fd;
+    const uint8_t *traceStart;
+    size_t traceSize;
+    size_t traceOffset;
+    // Start of the part of the trace still mapped in memory
+    size_t releasedOffset;
+    uint64_t numRecords;
+    uint64_t nextId;
+
+    // Packets read but not delivered yet
+    std::unordered_map<uint64_t, PendingPacket> pending;
+
+    // Release cycle of the packets with all their dependencies met,
+    // earliest first
+    typedef std::pair<Cycles, uint64_t> ReadyPacket;
+    std::priority_queue<ReadyPacket, std::vector<ReadyPacket>,
+                        std::greater<ReadyPacket>> ready;
+
+    // NetDest of each node, shared by all the packets sent to it
+    std::vector<ruby::NetDest> destNetDests;
+};
+
+} // namespace gem5
+
+#endif // __CPU_GARNET_TRACE_REPLAY_HH__
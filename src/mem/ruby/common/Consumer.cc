@@ -40,6 +40,10 @@
 
 #include "mem/ruby/common/Consumer.hh"
 
+#include <algorithm>
+
+#include "base/bitfield.hh"
+
 namespace gem5
 {
 
@@ -47,33 +51,100 @@ namespace ruby
 {
 
 Consumer::Consumer(ClockedObject *_em, Event::Priority ev_prio)
-    : m_wakeup_event([this]{ processCurrentEvent(); },
+    : m_wheel(0), m_wheel_base(0), m_wheel_period(0),
+      m_wakeup_event([this]{ processCurrentEvent(); },
                     "Consumer Event", false, ev_prio),
       em(_em)
 { }
 
+int
+Consumer::wheelSlot(Tick when) const
+{
+    if (when < m_wheel_base)
+        return -1;
+    Tick offset = when - m_wheel_base;
+    if (offset % m_wheel_period != 0 ||
+        offset / m_wheel_period >= WheelCycles)
+        return -1;
+    return offset / m_wheel_period;
+}
+
+// Moves the start of the wheel to the current clock edge. The wakeups
+// it skips are in the past, and have all been processed already.
+void
+Consumer::advanceWheel()
+{
+    Tick now = em->clockEdge();
+    Tick period = em->clockPeriod();
+
+    if (period != m_wheel_period) {
+        // The clock changed: keep the pending wakeups at their tick
+        for (uint64_t wheel = m_wheel; wheel; wheel &= wheel - 1) {
+            m_far_wakeups.insert(m_wheel_base +
+                                 ctz64(wheel) * m_wheel_period);
+        }
+        m_wheel = 0;
+        m_wheel_period = period;
+    }
+
+    if (m_wheel == 0) {
+        m_wheel_base = now;
+    } else if (now > m_wheel_base) {
+        Tick shift = (now - m_wheel_base) / period;
+        m_wheel = shift < WheelCycles ? m_wheel >> shift : 0;
+        m_wheel_base += shift * period;
+    }
+}
+
+void
+Consumer::insertWakeup(Tick when)
+{
+    advanceWheel();
+    int slot = wheelSlot(when);
+    if (slot >= 0)
+        m_wheel |= 1ULL << slot;
+    else
+        m_far_wakeups.insert(when);
+}
+
+bool
+Consumer::alreadyScheduled(Tick time)
+{
+    advanceWheel();
+    int slot = wheelSlot(time);
+    if (slot >= 0 && bits(m_wheel, slot))
+        return true;
+    return m_far_wakeups.find(time) != m_far_wakeups.end();
+}
+
 void
 Consumer::scheduleEvent(Cycles timeDelta)
 {
-    m_wakeup_ticks.insert(em->clockEdge(timeDelta));
+    insertWakeup(em->clockEdge(timeDelta));
     scheduleNextWakeup();
 }
 
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
-    m_wakeup_ticks.insert(
-        divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
+    insertWakeup(divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
     scheduleNextWakeup();
 }
 
 void
 Consumer::scheduleNextWakeup()
 {
-    // look for the next tick in the future to schedule
-    auto it = m_wakeup_ticks.lower_bound(em->clockEdge());
-    if (it != m_wakeup_ticks.end()) {
-        Tick when = *it;
+    // look for the next tick in the future to schedule, the first slot of
+    // the wheel unless a wakeup off the wheel comes earlier
+    advanceWheel();
+    Tick when = MaxTick;
+    if (m_wheel)
+        when = m_wheel_base + ctz64(m_wheel) * m_wheel_period;
+    auto it = m_far_wakeups.lower_bound(em->clockEdge());
+    if (it != m_far_wakeups.end())
+        when = std::min(when, *it);
+
+    if (when != MaxTick) {
         assert(when >= em->clockEdge());
         if (m_wakeup_event.scheduled() && (when < m_wakeup_event.when()))
             em->reschedule(m_wakeup_event, when, true);
@@ -85,12 +156,23 @@ Consumer::scheduleNextWakeup()
 void
 Consumer::processCurrentEvent()
 {
-    auto curr = m_wakeup_ticks.begin();
-    assert(em->clockEdge() == *curr);
-
     // remove the current tick from the wakeup list, wake up, and then schedule
-    // the next wakeup
-    m_wakeup_ticks.erase(curr);
+    // the next wakeup. The tick may be both on the wheel and, if it was
+    // scheduled while beyond the wheel, in the far set.
+    advanceWheel();
+    Tick now = em->clockEdge();
+    [[maybe_unused]] bool found = false;
+    if (m_wheel_base == now && bits(m_wheel, 0)) {
+        m_wheel &= ~1ULL;
+        found = true;
+    }
+    auto curr = m_far_wakeups.begin();
+    if (curr != m_far_wakeups.end() && *curr == now) {
+        m_far_wakeups.erase(curr);
+        found = true;
+    }
+    assert(found);
+
     wakeup();
     scheduleNextWakeup();
 }
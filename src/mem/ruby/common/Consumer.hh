@@ -47,6 +47,7 @@
 #ifndef __MEM_RUBY_COMMON_CONSUMER_HH__
 #define __MEM_RUBY_COMMON_CONSUMER_HH__
 
+#include <cstdint>
 #include <iostream>
 #include <set>
 
@@ -72,11 +73,7 @@ class Consumer
     virtual void print(std::ostream& out) const = 0;
     virtual void storeEventInfo(int info) {}
 
-    bool
-    alreadyScheduled(Tick time)
-    {
-        return m_wakeup_ticks.find(time) != m_wakeup_ticks.end();
-    }
+    bool alreadyScheduled(Tick time);
 
     ClockedObject *
     getObject()
@@ -88,10 +85,22 @@ class Consumer
     void scheduleEvent(Cycles timeDelta);
 
   private:
-    std::set<Tick> m_wakeup_ticks;
+    // Pending wakeups. Those in the next WheelCycles cycles are kept in a
+    // timing wheel, one bit per cycle starting at m_wheel_base; the
+    // others, and any that is not on a clock edge, in m_far_wakeups.
+    static constexpr int WheelCycles = 64;
+    uint64_t m_wheel;
+    Tick m_wheel_base;
+    Tick m_wheel_period;
+    std::set<Tick> m_far_wakeups;
+
     EventFunctionWrapper m_wakeup_event;
     ClockedObject *em;
 
+    // Wheel slot of a tick, or -1 if it is not covered by the wheel
+    int wheelSlot(Tick when) const;
+    void advanceWheel();
+    void insertWakeup(Tick when);
     void scheduleNextWakeup();
     void processCurrentEvent();
 };
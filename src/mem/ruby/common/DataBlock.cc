@@ -40,6 +40,10 @@
 
 #include "mem/ruby/common/DataBlock.hh"
 
+#include <algorithm>
+#include <cstring>
+
+#include "base/bitfield.hh"
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
@@ -51,17 +55,16 @@ namespace ruby
 
 DataBlock::DataBlock(const DataBlock &cp)
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
+    alloc();
     memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
-    m_alloc = true;
 }
 
 void
 DataBlock::alloc()
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    m_alloc = true;
-    clear();
+    int size = RubySystem::getBlockSizeBytes();
+    m_data = size > InlineBytes ? new uint8_t[size] : m_inline;
+    memset(m_data, 0, size);
 }
 
 void
@@ -79,8 +82,18 @@ DataBlock::equal(const DataBlock& obj) const
 void
 DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 {
-    for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
-        if (mask.getMask(i, 1)) {
+    // One mask word covers 64 bytes: copy them whole when all are set,
+    // otherwise only the bytes whose bits are set
+    int size = RubySystem::getBlockSizeBytes();
+    for (int base = 0; base < size; base += WriteMask::WordBits) {
+        uint64_t word = mask.getWord(base / WriteMask::WordBits);
+        int len = std::min(size - base, WriteMask::WordBits);
+        if (word == gem5::mask(len)) {
+            memcpy(&m_data[base], &dblk.m_data[base], len);
+            continue;
+        }
+        for (; word; word &= word - 1) {
+            int i = base + ctz64(word);
             m_data[i] = dblk.m_data[i];
         }
     }
@@ -89,9 +102,7 @@ DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 void
 DataBlock::atomicPartial(const DataBlock &dblk, const WriteMask &mask)
 {
-    for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
-        m_data[i] = dblk.m_data[i];
-    }
+    memcpy(m_data, dblk.m_data, RubySystem::getBlockSizeBytes());
     mask.performAtomic(m_data);
 }
 
@@ -69,14 +69,12 @@ class DataBlock
 
     ~DataBlock()
     {
-        if (m_alloc)
+        if (m_data != m_inline)
             delete [] m_data;
     }
 
     DataBlock& operator=(const DataBlock& obj);
 
-    void assign(uint8_t *data);
-
     void clear();
     uint8_t getByte(int whichByte) const;
     const uint8_t *getData(int offset, int len) const;
@@ -90,23 +88,16 @@ class DataBlock
     bool equal(const DataBlock& obj) const;
     void print(std::ostream& out) const;
 
+    // Blocks up to this size are stored in the DataBlock itself; larger
+    // ones fall back to a heap allocation
+    static const int InlineBytes = 64;
+
   private:
     void alloc();
     uint8_t *m_data;
-    bool m_alloc;
+    alignas(8) uint8_t m_inline[InlineBytes];
 };
 
-inline void
-DataBlock::assign(uint8_t *data)
-{
-    assert(data != NULL);
-    if (m_alloc) {
-        delete [] m_data;
-    }
-    m_data = data;
-    m_alloc = false;
-}
-
 inline uint8_t
 DataBlock::getByte(int whichByte) const
 {
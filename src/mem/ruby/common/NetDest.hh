@@ -93,6 +93,14 @@ class NetDest
     void resize();
     int getSize() const { return m_bits.size(); }
 
+    // Destinations of one machine type
+    const Set &
+    getMachineSet(MachineType machine) const
+    {
+        assert(machine < m_bits.size());
+        return m_bits[MachineType_base_level(machine)];
+    }
+
     // get element for a index
     NodeID elementAt(MachineID index);
 
@@ -34,6 +34,7 @@
 
 #include <bitset>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 
 #include "base/logging.hh"
@@ -207,6 +208,25 @@ class Set
 
     int getSize() const { return m_nSize; }
 
+    // The elements as 64-bit words, element i in bit i % 64 of word
+    // i / 64, to save and restore sets
+    int numWords() const { return (m_nSize + 63) / 64; }
+
+    uint64_t
+    getWord(int i) const
+    {
+        const std::bitset<NUMBER_BITS_PER_SET> word_mask(~0ULL);
+        return ((bits >> (64 * i)) & word_mask).to_ullong();
+    }
+
+    void
+    setWord(int i, uint64_t word)
+    {
+        const std::bitset<NUMBER_BITS_PER_SET> word_mask(~0ULL);
+        bits &= ~(word_mask << (64 * i));
+        bits |= std::bitset<NUMBER_BITS_PER_SET>(word) << (64 * i);
+    }
+
     void
     setSize(int size)
     {
@@ -41,12 +41,15 @@
 #ifndef __MEM_RUBY_COMMON_WRITEMASK_HH__
 #define __MEM_RUBY_COMMON_WRITEMASK_HH__
 
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <vector>
 
 #include "base/amo.hh"
+#include "base/bitfield.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/TypeDefines.hh"
 
@@ -61,19 +64,30 @@ class WriteMask
   public:
     typedef std::vector<std::pair<int, AtomicOpFunctor* >> AtomicOpVector;
 
+    // The mask is kept in place, one bit per byte in 64-bit words, and
+    // works a word at a time. Bits past mSize are always clear.
+    static const int WordBits = 64;
+    static const int MaxBytes = 512;
+
     WriteMask();
 
     WriteMask(int size)
-      : mSize(size), mMask(size, false), mAtomic(false)
-    {}
+      : mSize(size), mWords{}, mAtomic(false)
+    {
+        assert(size <= MaxBytes);
+    }
 
     WriteMask(int size, std::vector<bool> & mask)
-      : mSize(size), mMask(mask), mAtomic(false)
-    {}
+      : mSize(size), mWords{}, mAtomic(false)
+    {
+        setFromVector(mask);
+    }
 
     WriteMask(int size, std::vector<bool> &mask, AtomicOpVector atomicOp)
-      : mSize(size), mMask(mask), mAtomic(true), mAtomicOp(atomicOp)
-    {}
+      : mSize(size), mWords{}, mAtomic(true), mAtomicOp(atomicOp)
+    {
+        setFromVector(mask);
+    }
 
     ~WriteMask()
     {}
@@ -81,75 +95,79 @@ class WriteMask
     void
     clear()
     {
-        mMask = std::vector<bool>(mSize, false);
+        mWords.fill(0);
     }
 
     bool
     test(int offset) const
     {
         assert(offset < mSize);
-        return mMask[offset];
+        return bits(mWords[offset / WordBits], offset % WordBits);
     }
 
     void
     setMask(int offset, int len, bool val = true)
     {
         assert(mSize >= (offset + len));
-        for (int i = 0; i < len; i++) {
-            mMask[offset + i] = val;
+        for (int end = offset + len; offset < end;) {
+            int n = std::min(WordBits - offset % WordBits, end - offset);
+            uint64_t range = rangeBits(offset % WordBits, n);
+            if (val)
+                mWords[offset / WordBits] |= range;
+            else
+                mWords[offset / WordBits] &= ~range;
+            offset += n;
         }
     }
+
     void
     fillMask()
     {
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = true;
-        }
+        for (int i = 0; i < numWords(); i++)
+            mWords[i] = validBits(i);
     }
 
     bool
     getMask(int offset, int len) const
     {
-        bool tmp = true;
         assert(mSize >= (offset + len));
-        for (int i = 0; i < len; i++) {
-            tmp = tmp & mMask.at(offset + i);
+        for (int end = offset + len; offset < end;) {
+            int n = std::min(WordBits - offset % WordBits, end - offset);
+            uint64_t range = rangeBits(offset % WordBits, n);
+            if ((mWords[offset / WordBits] & range) != range)
+                return false;
+            offset += n;
         }
-        return tmp;
+        return true;
     }
 
     bool
     isOverlap(const WriteMask &readMask) const
     {
-        bool tmp = false;
         assert(mSize == readMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            if (readMask.mMask.at(i)) {
-                tmp = tmp | mMask.at(i);
-            }
+        for (int i = 0; i < numWords(); i++) {
+            if (mWords[i] & readMask.mWords[i])
+                return true;
         }
-        return tmp;
+        return false;
     }
 
     bool
     containsMask(const WriteMask &readMask) const
     {
-        bool tmp = true;
         assert(mSize == readMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            if (readMask.mMask.at(i)) {
-                tmp = tmp & mMask.at(i);
-            }
+        for (int i = 0; i < numWords(); i++) {
+            if (readMask.mWords[i] & ~mWords[i])
+                return false;
         }
-        return tmp;
+        return true;
     }
 
     bool isEmpty() const
     {
-        for (int i = 0; i < mSize; i++) {
-            if (mMask.at(i)) {
+        for (int i = 0; i < numWords(); i++) {
+            if (mWords[i])
                 return false;
-            }
         }
         return true;
     }
@@ -157,10 +175,9 @@ class WriteMask
     bool
     isFull() const
     {
-        for (int i = 0; i < mSize; i++) {
-            if (!mMask.at(i)) {
+        for (int i = 0; i < numWords(); i++) {
+            if (mWords[i] != validBits(i))
                 return false;
-            }
         }
         return true;
     }
@@ -169,9 +186,8 @@ class WriteMask
     andMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = (mMask.at(i)) && (writeMask.mMask.at(i));
-        }
+        for (int i = 0; i < numWords(); i++)
+            mWords[i] &= writeMask.mWords[i];
 
         if (writeMask.mAtomic) {
             mAtomic = true;
@@ -183,9 +199,8 @@ class WriteMask
     orMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = (mMask.at(i)) || (writeMask.mMask.at(i));
-        }
+        for (int i = 0; i < numWords(); i++)
+            mWords[i] |= writeMask.mWords[i];
 
         if (writeMask.mAtomic) {
             mAtomic = true;
@@ -197,17 +212,20 @@ class WriteMask
     setInvertedMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = !writeMask.mMask.at(i);
-        }
+        for (int i = 0; i < numWords(); i++)
+            mWords[i] = ~writeMask.mWords[i] & validBits(i);
     }
 
     int
     firstBitSet(bool val, int offset = 0) const
     {
-        for (int i = offset; i < mSize; ++i)
-            if (mMask[i] == val)
-                return i;
+        for (int i = offset / WordBits; i < numWords(); i++) {
+            uint64_t word = (val ? mWords[i] : ~mWords[i]) & validBits(i);
+            if (i == offset / WordBits)
+                word &= ~mask(offset % WordBits);
+            if (word)
+                return i * WordBits + ctz64(word);
+        }
         return mSize;
     }
 
@@ -215,11 +233,18 @@ class WriteMask
     count(int offset = 0) const
     {
         int count = 0;
-        for (int i = offset; i < mSize; ++i)
-            count += mMask[i];
+        for (int i = offset / WordBits; i < numWords(); i++) {
+            uint64_t word = mWords[i];
+            if (i == offset / WordBits)
+                word &= ~mask(offset % WordBits);
+            count += popCount(word);
+        }
         return count;
     }
 
+    // Bytes [64 * i, 64 * i + 64) of the mask, one bit per byte
+    uint64_t getWord(int i) const { return mWords[i]; }
+
     void print(std::ostream& out) const;
 
     void
@@ -257,8 +282,35 @@ class WriteMask
     }
 
   private:
+    int numWords() const { return (mSize + WordBits - 1) / WordBits; }
+
+    // Bits of word i within the mask
+    uint64_t
+    validBits(int i) const
+    {
+        return mask(std::min(mSize - i * WordBits, WordBits));
+    }
+
+    // n bits from bit first of a word
+    static uint64_t
+    rangeBits(int first, int n)
+    {
+        return mask(n) << first;
+    }
+
+    void
+    setFromVector(const std::vector<bool> &vec)
+    {
+        assert(mSize <= MaxBytes);
+        assert(vec.size() >= mSize);
+        for (int i = 0; i < mSize; i++) {
+            if (vec[i])
+                mWords[i / WordBits] |= 1ULL << (i % WordBits);
+        }
+    }
+
     int mSize;
-    std::vector<bool> mMask;
+    std::array<uint64_t, MaxBytes / WordBits> mWords;
     bool mAtomic;
     AtomicOpVector mAtomicOp;
 };
@@ -48,6 +48,12 @@ class RubyNetwork(ClockedObject):
         "highest numbered vnet in use."
     )
     control_msg_size = Param.Int(8, "")
+    route_cache_dir = Param.String(
+        "",
+        "Directory caching the routing tables computed for each "
+        "topology, so that later runs of the same topology skip the "
+        "computation. Empty disables the cache.",
+    )
     ruby_system = Param.RubySystem("")
 
     routers = VectorParam.BasicRouter("Network routers")
@@ -29,8 +29,18 @@
 
 #include "mem/ruby/network/Topology.hh"
 
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 
+#include "base/bitfield.hh"
+#include "base/cprintf.hh"
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/common/NetDest.hh"
@@ -56,10 +66,12 @@ const int INFINITE_LATENCY = 10000; // Yes, this is a big hack
 Topology::Topology(uint32_t num_nodes, uint32_t num_routers,
                    uint32_t num_vnets,
                    const std::vector<BasicExtLink *> &ext_links,
-                   const std::vector<BasicIntLink *> &int_links)
+                   const std::vector<BasicIntLink *> &int_links,
+                   const std::string &route_cache_dir)
     : m_nodes(MachineType_base_number(MachineType_NUM)),
       m_number_of_switches(num_routers), m_vnets(num_vnets),
-      m_ext_link_vector(ext_links), m_int_link_vector(int_links)
+      m_ext_link_vector(ext_links), m_int_link_vector(int_links),
+      m_route_cache_dir(route_cache_dir)
 {
     // Total nodes/controllers in network
     assert(m_nodes > 1);
@@ -111,48 +123,25 @@ Topology::Topology(uint32_t num_nodes, uint32_t num_routers,
     }
 }
 
-void
-Topology::createLinks(Network *net)
+std::vector<Topology::WeightedLink>
+Topology::weightedLinks() const
 {
-    // Find maximum switchID
-    SwitchID max_switch_id = 0;
-    for (LinkMap::const_iterator i = m_link_map.begin();
-         i != m_link_map.end(); ++i) {
-        std::pair<SwitchID, SwitchID> src_dest = (*i).first;
-        max_switch_id = std::max(max_switch_id, src_dest.first);
-        max_switch_id = std::max(max_switch_id, src_dest.second);
-    }
+    std::vector<WeightedLink> links;
 
-    // Initialize weight, latency, and inter switched vectors
-    int num_switches = max_switch_id+1;
-    Matrix topology_weights(m_vnets,
-            std::vector<std::vector<int>>(num_switches,
-            std::vector<int>(num_switches, INFINITE_LATENCY)));
-    Matrix component_latencies(num_switches,
-            std::vector<std::vector<int>>(num_switches,
-            std::vector<int>(m_vnets, -1)));
-    Matrix component_inter_switches(num_switches,
-            std::vector<std::vector<int>>(num_switches,
-            std::vector<int>(m_vnets, 0)));
-
-    // Set identity weights to zero
-    for (int i = 0; i < topology_weights[0].size(); i++) {
-        for (int v = 0; v < m_vnets; v++) {
-            topology_weights[v][i][i] = 0;
-        }
-    }
-
-    // Fill in the topology weights and bandwidth multipliers
-    for (auto link_group : m_link_map) {
-        std::pair<int, int> src_dest = link_group.first;
+    // Fill in the weights of the links for each vnet
+    for (auto &link_group : m_link_map) {
         std::vector<bool> vnet_done(m_vnets, 0);
-        int src = src_dest.first;
-        int dst = src_dest.second;
+        WeightedLink weighted_link;
+        weighted_link.src = link_group.first.first;
+        weighted_link.dest = link_group.first.second;
+        weighted_link.weights.assign(m_vnets, INFINITE_LATENCY);
 
         // Iterate over all links for this source and destination
-        std::vector<LinkEntry> link_entries = link_group.second;
-        for (int l = 0; l < link_entries.size(); l++) {
-            BasicLink* link = link_entries[l].link;
+        for (auto &link_entry : link_group.second) {
+            BasicLink* link = link_entry.link;
+            fatal_if(link->m_weight < 0 || link->m_weight > INFINITE_LATENCY,
+                     "Link weights must be between 0 and %d",
+                     INFINITE_LATENCY);
             if (link->mVnets.size() == 0) {
                 for (int v = 0; v < m_vnets; v++) {
                     // Two links connecting same src and destination
@@ -160,8 +149,7 @@ Topology::createLinks(Network *net)
                     fatal_if(vnet_done[v], "Two links connecting same src"
                     " and destination cannot support same vnets");
 
-                    component_latencies[src][dst][v] = link->m_latency;
-                    topology_weights[v][src][dst] = link->m_weight;
+                    weighted_link.weights[v] = link->m_weight;
                     vnet_done[v] = true;
                 }
             } else {
@@ -174,43 +162,47 @@ Topology::createLinks(Network *net)
                     fatal_if(vnet_done[vnet], "Two links connecting same src"
                     " and destination cannot support same vnets");
 
-                    component_latencies[src][dst][vnet] = link->m_latency;
-                    topology_weights[vnet][src][dst] = link->m_weight;
+                    weighted_link.weights[vnet] = link->m_weight;
                     vnet_done[vnet] = true;
                 }
             }
         }
+        links.push_back(weighted_link);
+    }
+    return links;
+}
+
+void
+Topology::createLinks(Network *net)
+{
+    std::vector<WeightedLink> links = weightedLinks();
+
+    RouteTable routes;
+    std::vector<int32_t> cache_key;
+    if (!m_route_cache_dir.empty())
+        cache_key = routeCacheKey(links);
+    if (cache_key.empty() || !readRouteCache(cache_key, routes)) {
+        routes = shortestPathRoutes(links);
+        if (!cache_key.empty())
+            writeRouteCache(cache_key, routes);
     }
 
-    // Walk topology and hookup the links
-    Matrix dist = shortest_path(topology_weights, component_latencies,
-                                component_inter_switches);
-
-    for (int i = 0; i < topology_weights[0].size(); i++) {
-        for (int j = 0; j < topology_weights[0][i].size(); j++) {
-            std::vector<NetDest> routingMap;
-            routingMap.resize(m_vnets);
-
-            // Not all sources and destinations are connected
-            // by direct links. We only construct the links
-            // which have been configured in topology.
-            bool realLink = false;
-
-            for (int v = 0; v < m_vnets; v++) {
-                int weight = topology_weights[v][i][j];
-                if (weight > 0 && weight != INFINITE_LATENCY) {
-                    realLink = true;
-                    routingMap[v] =
-                        shortest_path_to_node(i, j, topology_weights, dist, v);
-                }
-            }
-            // Make one link for each set of vnets between
-            // a given source and destination. We do not
-            // want to create one link for each vnet.
-            if (realLink) {
-                makeLink(net, i, j, routingMap);
-            }
+    // Walk topology and hookup the links, in (src, dest) order
+    for (int l = 0; l < links.size(); l++) {
+        // Not all sources and destinations are connected
+        // by direct links. We only construct the links
+        // which have been configured in topology.
+        bool realLink = false;
+        for (int v = 0; v < m_vnets; v++) {
+            int weight = links[l].weights[v];
+            if (weight > 0 && weight != INFINITE_LATENCY)
+                realLink = true;
         }
+        // Make one link for each set of vnets between
+        // a given source and destination. We do not
+        // want to create one link for each vnet.
+        if (realLink)
+            makeLink(net, links[l].src, links[l].dest, routes[l]);
     }
 }
 
@@ -330,120 +322,329 @@ Topology::makeLink(Network *net, SwitchID src, SwitchID dest,
     }
 }
 
-// The following all-pairs shortest path algorithm is based on the
-// discussion from Cormen et al., Chapter 26.1.
+namespace
+{
+
+// Distances from src to every router over router_links, with Dial's
+// algorithm since link weights are small integers. Distances of at
+// least INFINITE_LATENCY are left at INFINITE_LATENCY.
 void
-Topology::extend_shortest_path(Matrix &current_dist, Matrix &latencies,
-    Matrix &inter_switches)
+routerDistances(int src,
+                const std::vector<std::vector<std::pair<int, int>>>
+                    &router_links,
+                int *dist, std::vector<std::vector<int>> &buckets)
+{
+    std::fill(dist, dist + router_links.size(), INFINITE_LATENCY);
+    dist[src] = 0;
+    buckets[0].push_back(src);
+    for (int d = 0; d < buckets.size(); d++) {
+        // Links of weight 0 add to the bucket being walked
+        for (int i = 0; i < buckets[d].size(); i++) {
+            int router = buckets[d][i];
+            if (dist[router] != d)
+                continue;
+            for (auto [next, weight] : router_links[router]) {
+                int next_dist = d + weight;
+                if (next_dist < dist[next]) {
+                    dist[next] = next_dist;
+                    if (next_dist >= buckets.size())
+                        buckets.resize(next_dist + 1);
+                    buckets[next_dist].push_back(next);
+                }
+            }
+        }
+        buckets[d].clear();
+    }
+}
+
+// MachineID of each global node id
+std::vector<MachineID>
+nodeMachineIDs()
 {
-    int nodes = current_dist[0].size();
+    std::vector<MachineID> machines;
+    for (int m = 0; m < MachineType_NUM; m++) {
+        for (NodeID i = 0; i < MachineType_base_count((MachineType)m); i++)
+            machines.push_back({(MachineType)m, i});
+    }
+    return machines;
+}
+
+// Destination nodes whose routes are computed together
+const int nodeBlock = 64;
+
+const char routeCacheMagic[8] = {'R', 'U', 'B', 'Y', 'R', 'T', 'E', 'S'};
+const int32_t routeCacheVersion = 2;
+
+} // anonymous namespace
+
+// A link is on a shortest path to a destination if its weight plus the
+// distance from its end to the destination is the distance from its
+// start. Only the distances to the destination nodes are needed: they
+// are derived from the distances between routers, computed from each
+// router, as the endpoint switches only link to and from routers.
+Topology::RouteTable
+Topology::shortestPathRoutes(const std::vector<WeightedLink> &links) const
+{
+    SwitchID max_switch_id = 0;
+    for (auto &link : links)
+        max_switch_id = std::max({max_switch_id, link.src, link.dest});
+    int num_routers = std::max<int>(max_switch_id + 1 - 2 * m_nodes, 0);
+
+    RouteTable routes(links.size(), std::vector<NetDest>(m_vnets));
+    std::vector<MachineID> machines = nodeMachineIDs();
+
+    std::vector<std::vector<std::pair<int, int>>> router_links;
+    // Routers linked to the output switch of each node, and routers
+    // linked from the input switch of each node
+    std::vector<std::vector<std::pair<int, int>>> node_in_links;
+    std::vector<std::vector<std::pair<int, int>>> node_out_links;
+    // Distances between routers, [src * num_routers + dest]
+    std::vector<int> router_dist((size_t) num_routers * num_routers);
+    std::vector<std::vector<int>> buckets(1);
+    // Distance from each router to each node of a block of destination
+    // nodes, [router * nodeBlock + node - first node of the block]. The
+    // links are walked once per block, not once per node.
+    std::vector<int> dist_to_node((size_t) num_routers * nodeBlock);
 
-    // We find the shortest path for each vnet for a given pair of
-    // source and destinations. This is done simply by traversing via
-    // all other nodes and finding the minimum distance.
     for (int v = 0; v < m_vnets; v++) {
-        // There is a different topology for each vnet. Here we try to
-        // build a topology by finding the minimum number of intermediate
-        // switches needed to reach the destination
-        bool change = true;
-        while (change) {
-            change = false;
-            for (int i = 0; i < nodes; i++) {
-                for (int j = 0; j < nodes; j++) {
-                    // We follow an iterative process to build the shortest
-                    // path tree:
-                    // 1. Start from the direct connection (if there is one,
-                    // otherwise assume a hypothetical infinite weight link).
-                    // 2. Then we iterate through all other nodes considering
-                    // new potential intermediate switches. If we find any
-                    // lesser weight combination, we set(update) that as the
-                    // new weight between the source and destination.
-                    // 3. Repeat for all pairs of nodes.
-                    // 4. Go to step 1 if there was any new update done in
-                    // Step 2.
-                    int minimum = current_dist[v][i][j];
-                    int previous_minimum = minimum;
-                    int intermediate_switch = -1;
-                    for (int k = 0; k < nodes; k++) {
-                        minimum = std::min(minimum,
-                            current_dist[v][i][k] + current_dist[v][k][j]);
-                        if (previous_minimum != minimum) {
-                            intermediate_switch = k;
-                            inter_switches[i][j][v] =
-                                inter_switches[i][k][v] +
-                                inter_switches[k][j][v] + 1;
-                        }
-                        previous_minimum = minimum;
-                    }
-                    if (current_dist[v][i][j] != minimum) {
-                        change = true;
-                        current_dist[v][i][j] = minimum;
-                        assert(intermediate_switch >= 0);
-                        assert(intermediate_switch < latencies[i].size());
-                        latencies[i][j][v] =
-                            latencies[i][intermediate_switch][v] +
-                            latencies[intermediate_switch][j][v];
+        // Vnets with the same link weights have the same routes
+        int same_vnet = 0;
+        while (same_vnet < v &&
+               !std::all_of(links.begin(), links.end(),
+                            [&](const WeightedLink &link) {
+                                return link.weights[same_vnet] ==
+                                       link.weights[v];
+                            })) {
+            same_vnet++;
+        }
+        if (same_vnet < v) {
+            for (int l = 0; l < links.size(); l++)
+                routes[l][v] = routes[l][same_vnet];
+            continue;
+        }
+
+        router_links.assign(num_routers, {});
+        node_in_links.assign(m_nodes, {});
+        node_out_links.assign(m_nodes, {});
+        for (auto &link : links) {
+            int weight = link.weights[v];
+            if (weight == INFINITE_LATENCY)
+                continue;
+            if (link.src < m_nodes) {
+                node_out_links[link.src].emplace_back(
+                    link.dest - 2 * m_nodes, weight);
+            } else if (link.dest < 2 * m_nodes) {
+                node_in_links[link.dest - m_nodes].emplace_back(
+                    link.src - 2 * m_nodes, weight);
+            } else {
+                router_links[link.src - 2 * m_nodes].emplace_back(
+                    link.dest - 2 * m_nodes, weight);
+            }
+        }
+
+        for (int r = 0; r < num_routers; r++) {
+            routerDistances(r, router_links,
+                            &router_dist[(size_t) r * num_routers], buckets);
+        }
+
+        for (NodeID first = 0; first < m_nodes; first += nodeBlock) {
+            int block = std::min<int>(nodeBlock, m_nodes - first);
+            for (int r = 0; r < num_routers; r++) {
+                const int *dist_from_r =
+                    &router_dist[(size_t) r * num_routers];
+                for (int k = 0; k < block; k++) {
+                    int dist = INFINITE_LATENCY;
+                    for (auto [last, weight] : node_in_links[first + k])
+                        dist = std::min(dist, dist_from_r[last] + weight);
+                    dist_to_node[(size_t) r * nodeBlock + k] = dist;
+                }
+            }
+
+            auto switch_dist = [&](SwitchID s, int k) {
+                if (s >= 2 * m_nodes) {
+                    return dist_to_node[(size_t) (s - 2 * m_nodes) *
+                                        nodeBlock + k];
+                }
+                if (s >= m_nodes)
+                    return s == first + k + m_nodes ? 0 : INFINITE_LATENCY;
+                int dist = INFINITE_LATENCY;
+                for (auto [next, weight] : node_out_links[s]) {
+                    dist = std::min(dist, weight +
+                        dist_to_node[(size_t) next * nodeBlock + k]);
+                }
+                return dist;
+            };
+
+            for (int l = 0; l < links.size(); l++) {
+                int weight = links[l].weights[v];
+                if (weight <= 0 || weight == INFINITE_LATENCY)
+                    continue;
+                for (int k = 0; k < block; k++) {
+                    if (weight + switch_dist(links[l].dest, k) ==
+                        switch_dist(links[l].src, k)) {
+                        routes[l][v].add(machines[first + k]);
                     }
                 }
             }
         }
     }
+
+    for (int l = 0; l < links.size(); l++) {
+        for (int v = 0; v < m_vnets; v++) {
+            DPRINTF(RubyNetwork, "Returning shortest path\n"
+                    "(src-(2*max_machines)): %d, "
+                    "(next-(2*max_machines)): %d, "
+                    "src: %d, next: %d, vnet:%d result: %s\n",
+                    (links[l].src - (2 * m_nodes)),
+                    (links[l].dest - (2 * m_nodes)),
+                    links[l].src, links[l].dest, v, routes[l][v]);
+        }
+    }
+
+    return routes;
 }
 
-Matrix
-Topology::shortest_path(const Matrix &weights, Matrix &latencies,
-                        Matrix &inter_switches)
+std::vector<int32_t>
+Topology::routeCacheKey(const std::vector<WeightedLink> &links) const
 {
-    Matrix dist = weights;
-    extend_shortest_path(dist, latencies, inter_switches);
-    return dist;
+    std::vector<int32_t> key = {routeCacheVersion, (int32_t) m_nodes,
+                                m_vnets, MachineType_NUM};
+    for (int m = 0; m < MachineType_NUM; m++)
+        key.push_back(MachineType_base_count((MachineType)m));
+    key.push_back(links.size());
+    for (auto &link : links) {
+        key.push_back(link.src);
+        key.push_back(link.dest);
+        key.insert(key.end(), link.weights.begin(), link.weights.end());
+    }
+    return key;
 }
 
-bool
-Topology::link_is_shortest_path_to_node(SwitchID src, SwitchID next,
-                                        SwitchID final, const Matrix &weights,
-                                        const Matrix &dist, int vnet)
+std::string
+Topology::routeCacheFile(const std::vector<int32_t> &key) const
 {
-    return weights[vnet][src][next] + dist[vnet][next][final] ==
-        dist[vnet][src][final];
+    // FNV-1a hash of the key
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(key.data());
+    for (size_t i = 0; i < key.size() * sizeof(int32_t); i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return csprintf("%s/routes-%016x.bin", m_route_cache_dir, hash);
 }
 
-NetDest
-Topology::shortest_path_to_node(SwitchID src, SwitchID next,
-                                const Matrix &weights, const Matrix &dist,
-                                int vnet)
+bool
+Topology::readRouteCache(const std::vector<int32_t> &key,
+                         RouteTable &routes) const
 {
-    NetDest result;
-    int d = 0;
-    int machines;
-    int max_machines;
-
-    machines = MachineType_NUM;
-    max_machines = MachineType_base_number(MachineType_NUM);
-
-    for (int m = 0; m < machines; m++) {
-        for (NodeID i = 0; i < MachineType_base_count((MachineType)m); i++) {
-            // we use "d+max_machines" below since the "destination"
-            // switches for the machines are numbered
-            // [MachineType_base_number(MachineType_NUM)...
-            //  2*MachineType_base_number(MachineType_NUM)-1] for the
-            // component network
-            if (link_is_shortest_path_to_node(src, next, d + max_machines,
-                    weights, dist, vnet)) {
-                MachineID mach = {(MachineType)m, i};
-                result.add(mach);
+    std::string file_name = routeCacheFile(key);
+    std::ifstream file(file_name, std::ios::binary);
+    if (!file)
+        return false;
+
+    char magic[sizeof(routeCacheMagic)];
+    uint64_t key_size = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char *>(&key_size), sizeof(key_size));
+    if (!file || memcmp(magic, routeCacheMagic, sizeof(magic)) != 0 ||
+        key_size != key.size()) {
+        warn("Ignoring invalid route cache %s\n", file_name);
+        return false;
+    }
+
+    // A different topology with the same hash is not a hit
+    std::vector<int32_t> file_key(key_size);
+    file.read(reinterpret_cast<char *>(file_key.data()),
+              key_size * sizeof(int32_t));
+    if (!file || file_key != key)
+        return false;
+
+    // Each vnet of each link either refers to an earlier vnet of the
+    // link with the same routes, or holds the destination bit masks of
+    // every machine type
+    size_t num_links = key[4 + MachineType_NUM];
+    routes.assign(num_links, std::vector<NetDest>(m_vnets));
+    std::vector<uint64_t> words;
+    for (auto &link_routes : routes) {
+        for (int v = 0; v < m_vnets; v++) {
+            int32_t same_as = -1;
+            file.read(reinterpret_cast<char *>(&same_as), sizeof(same_as));
+            if (!file || same_as < -1 || same_as >= v) {
+                warn("Ignoring invalid route cache %s\n", file_name);
+                return false;
+            }
+            if (same_as >= 0) {
+                link_routes[v] = link_routes[same_as];
+                continue;
+            }
+
+            for (int m = 0; m < MachineType_NUM; m++) {
+                Set set(MachineType_base_count((MachineType)m));
+                words.resize(set.numWords());
+                file.read(reinterpret_cast<char *>(words.data()),
+                          words.size() * sizeof(uint64_t));
+                if (!file || (!words.empty() && (words.back() &
+                    ~mask(set.getSize() - 64 * (words.size() - 1))))) {
+                    warn("Ignoring invalid route cache %s\n", file_name);
+                    return false;
+                }
+                for (int w = 0; w < words.size(); w++)
+                    set.setWord(w, words[w]);
+                link_routes[v].setNetDest((MachineType)m, set);
             }
-            d++;
         }
     }
 
-    DPRINTF(RubyNetwork, "Returning shortest path\n"
-            "(src-(2*max_machines)): %d, (next-(2*max_machines)): %d, "
-            "src: %d, next: %d, vnet:%d result: %s\n",
-            (src-(2*max_machines)), (next-(2*max_machines)),
-            src, next, vnet, result);
+    DPRINTF(RubyNetwork, "Read the routes from %s\n", file_name);
+    return true;
+}
 
-    return result;
+void
+Topology::writeRouteCache(const std::vector<int32_t> &key,
+                          const RouteTable &routes) const
+{
+    // Several simulations may share the cache: write to a file of our
+    // own and move it in place once complete
+    std::string file_name = routeCacheFile(key);
+    std::string tmp_name = csprintf("%s.%d", file_name, getpid());
+    mkdir(m_route_cache_dir.c_str(), 0777);
+
+    std::ofstream file(tmp_name, std::ios::binary);
+    uint64_t key_size = key.size();
+    file.write(routeCacheMagic, sizeof(routeCacheMagic));
+    file.write(reinterpret_cast<const char *>(&key_size), sizeof(key_size));
+    file.write(reinterpret_cast<const char *>(key.data()),
+               key_size * sizeof(int32_t));
+    std::vector<uint64_t> words;
+    for (auto &link_routes : routes) {
+        for (int v = 0; v < m_vnets; v++) {
+            const NetDest &dest = link_routes[v];
+            int32_t same_as = -1;
+            for (int u = 0; u < v && same_as < 0; u++) {
+                if (link_routes[u].isEqual(dest))
+                    same_as = u;
+            }
+            file.write(reinterpret_cast<const char *>(&same_as),
+                       sizeof(same_as));
+            if (same_as >= 0)
+                continue;
+
+            words.clear();
+            for (int m = 0; m < MachineType_NUM; m++) {
+                const Set &set = dest.getMachineSet((MachineType)m);
+                for (int w = 0; w < set.numWords(); w++)
+                    words.push_back(set.getWord(w));
+            }
+            file.write(reinterpret_cast<const char *>(words.data()),
+                       words.size() * sizeof(uint64_t));
+        }
+    }
+    file.close();
+
+    if (!file || rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+        warn("Cannot write the route cache %s\n", file_name);
+        unlink(tmp_name.c_str());
+    }
 }
 
 } // namespace ruby
@@ -41,7 +41,9 @@
 #ifndef __MEM_RUBY_NETWORK_TOPOLOGY_HH__
 #define __MEM_RUBY_NETWORK_TOPOLOGY_HH__
 
+#include <cstdint>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #include "mem/ruby/common/TypeDefines.hh"
@@ -57,14 +59,6 @@ namespace ruby
 class NetDest;
 class Network;
 
-/*
- * We use a three-dimensional vector matrix for calculating
- * the shortest paths for each pair of source and destination
- * and for each type of virtual network. The three dimensions
- * represent the source ID, destination ID, and vnet number.
- */
-typedef std::vector<std::vector<std::vector<int>>> Matrix;
-
 struct LinkEntry
 {
     BasicLink *link;
@@ -80,33 +74,48 @@ class Topology
   public:
     Topology(uint32_t num_nodes, uint32_t num_routers, uint32_t num_vnets,
              const std::vector<BasicExtLink *> &ext_links,
-             const std::vector<BasicIntLink *> &int_links);
+             const std::vector<BasicIntLink *> &int_links,
+             const std::string &route_cache_dir = "");
 
     uint32_t numSwitches() const { return m_number_of_switches; }
     void createLinks(Network *net);
     void print(std::ostream& out) const { out << "[Topology]"; }
 
   private:
+    // A uni-directional link between two switches, with its weight for
+    // each vnet (INFINITE_LATENCY for the vnets it does not carry)
+    struct WeightedLink
+    {
+        SwitchID src;
+        SwitchID dest;
+        std::vector<int> weights;
+    };
+
+    // Routing table entry of each link, for each vnet
+    typedef std::vector<std::vector<NetDest>> RouteTable;
+
     void addLink(SwitchID src, SwitchID dest, BasicLink* link,
                  PortDirection src_outport_dirn = "",
                  PortDirection dest_inport_dirn = "");
     void makeLink(Network *net, SwitchID src, SwitchID dest,
                   std::vector<NetDest>& routing_table_entry);
 
-    // Helper functions based on chapter 29 of Cormen et al.
-    void extend_shortest_path(Matrix &current_dist, Matrix &latencies,
-                              Matrix &inter_switches);
-
-    Matrix shortest_path(const Matrix &weights,
-            Matrix &latencies, Matrix &inter_switches);
+    // Links of m_link_map, in its order, with their weights
+    std::vector<WeightedLink> weightedLinks() const;
 
-    bool link_is_shortest_path_to_node(SwitchID src, SwitchID next,
-            SwitchID final, const Matrix &weights, const Matrix &dist,
-            int vnet);
+    // Shortest path routes: the routing table entry of a link for a
+    // vnet holds the destinations it is on a shortest path to
+    RouteTable shortestPathRoutes(const std::vector<WeightedLink> &links)
+        const;
 
-    NetDest shortest_path_to_node(SwitchID src, SwitchID next,
-                                  const Matrix &weights, const Matrix &dist,
-                                  int vnet);
+    // On-disk cache of the routes, keyed by the topology
+    std::vector<int32_t> routeCacheKey(
+        const std::vector<WeightedLink> &links) const;
+    std::string routeCacheFile(const std::vector<int32_t> &key) const;
+    bool readRouteCache(const std::vector<int32_t> &key,
+                        RouteTable &routes) const;
+    void writeRouteCache(const std::vector<int32_t> &key,
+                         const RouteTable &routes) const;
 
     const uint32_t m_nodes;
     const uint32_t m_number_of_switches;
@@ -116,6 +125,9 @@ class Topology
     std::vector<BasicIntLink*> m_int_link_vector;
 
     LinkMap m_link_map;
+
+    // Directory of the route cache, empty if disabled
+    std::string m_route_cache_dir;
 };
 
 inline std::ostream&
@@ -31,7 +31,11 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_COMMONTYPES_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_COMMONTYPES_HH__
 
+#include <cassert>
+#include <cstdint>
+
 #include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/common/TypeDefines.hh"
 
 namespace gem5
 {
@@ -55,6 +59,57 @@ enum RoutingAlgorithm
     TABLE_ = 0, XY_ = 1, CUSTOM_ = 2, TORUS3D_ = 3, TORUS3D_ADAPTIVE_ = 4,
                         NUM_ROUTING_ALGORITHM_
 };
+enum TieBreakingPolicy {X_FIRST_, Z_FIRST_, UNIFORM_, NUM_TIE_BREAKING_};
+enum CongestionSensing {INSTANTANEOUS_, EWMA_, NUM_CONGESTION_SENSING_};
+
+// Port directions used by the direction-based routing algorithms.
+// The string names from the topology file are translated once, when the
+// ports are added to the router; everything after that works on the id.
+// The order of the directions is the X-first preference order.
+enum PortDirectionId
+{
+    LOCAL_, EAST_, WEST_, NORTH_, SOUTH_, UP_, DOWN_,
+    OTHER_DIRN_, NUM_PORT_DIRECTION_
+};
+
+// Set of directions, one bit per PortDirectionId
+typedef uint8_t PortDirectionMask;
+
+inline PortDirectionMask
+dirnBit(PortDirectionId dirn)
+{
+    return PortDirectionMask(1 << dirn);
+}
+
+inline PortDirectionId
+portDirectionFromName(const PortDirection &name)
+{
+    if (name == "Local")
+        return LOCAL_;
+    if (name == "East")
+        return EAST_;
+    if (name == "West")
+        return WEST_;
+    if (name == "North")
+        return NORTH_;
+    if (name == "South")
+        return SOUTH_;
+    if (name == "Up")
+        return UP_;
+    if (name == "Down")
+        return DOWN_;
+    return OTHER_DIRN_;
+}
+
+inline const char *
+portDirectionName(PortDirectionId dirn)
+{
+    static const char *names[NUM_PORT_DIRECTION_] = {
+        "Local", "East", "West", "North", "South", "Up", "Down", "Other"
+    };
+    assert(dirn < NUM_PORT_DIRECTION_);
+    return names[dirn];
+}
 
 struct RouteInfo
 {
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mem/ruby/network/garnet/FlitPool.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+FlitPool::FlitPool()
+    : m_free_list(nullptr), m_num_fresh(0), m_num_allocs(0), m_num_reuses(0),
+      m_num_in_use(0), m_high_water_mark(0)
+{
+}
+
+FlitPool::~FlitPool()
+{
+    // Flits still in flight when the simulation ends are not destroyed;
+    // their storage goes away with the chunks.
+}
+
+void *
+FlitPool::allocSlot()
+{
+    Slot *slot;
+    if (m_free_list != nullptr) {
+        // Recycle a released slot
+        slot = m_free_list;
+        m_free_list = slot->next;
+        m_num_reuses++;
+    } else {
+        // Hand out the next never-used slot, growing by one chunk
+        // when the current one is exhausted
+        if (m_num_fresh == 0) {
+            m_chunks.emplace_back(new Slot[chunkSize]);
+            m_num_fresh = chunkSize;
+        }
+        slot = &m_chunks.back()[chunkSize - m_num_fresh];
+        m_num_fresh--;
+    }
+
+    m_num_allocs++;
+    m_num_in_use++;
+    if (m_num_in_use > m_high_water_mark)
+        m_high_water_mark = m_num_in_use;
+
+    return slot->storage;
+}
+
+flit *
+FlitPool::allocFlit(int packet_id, int id, int vc, int vnet,
+                    RouteInfo route, int size, MsgPtr msg_ptr, int MsgSize,
+                    uint32_t bWidth, Tick curTime)
+{
+    flit *fl = new (allocSlot()) flit(packet_id, id, vc, vnet, route, size,
+                                      msg_ptr, MsgSize, bWidth, curTime);
+    fl->m_pool = this;
+    return fl;
+}
+
+Credit *
+FlitPool::allocCredit(int vc, bool is_free_signal, Tick curTime)
+{
+    Credit *credit = new (allocSlot()) Credit(vc, is_free_signal, curTime);
+    credit->m_pool = this;
+    return credit;
+}
+
+void
+FlitPool::release(flit *t_flit)
+{
+    assert(t_flit->m_pool);
+
+    t_flit->~flit();
+
+    Slot *slot = reinterpret_cast<Slot *>(t_flit);
+    slot->next = m_free_list;
+    m_free_list = slot;
+    m_num_in_use--;
+}
+
+void
+FlitPool::resetStats()
+{
+    m_num_allocs = 0;
+    m_num_reuses = 0;
+    m_high_water_mark = std::max<int64_t>(m_num_in_use, 0);
+}
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
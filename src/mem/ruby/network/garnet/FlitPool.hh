@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_RUBY_NETWORK_GARNET_0_FLITPOOL_HH__
+#define __MEM_RUBY_NETWORK_GARNET_0_FLITPOOL_HH__
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/ruby/network/garnet/CommonTypes.hh"
+#include "mem/ruby/network/garnet/Credit.hh"
+#include "mem/ruby/network/garnet/flit.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+// Free-list allocator for the flits and credits of one GarnetNetwork.
+// Storage is carved out of fixed-size chunks and recycled on release,
+// so that steady-state traffic does not go through the global heap.
+// Every flit remembers the pool it came from, so objects can be
+// released (and serialized by the NetworkBridge) without a pointer to
+// the network.
+//
+// A network partitioned across event queues has one pool per queue.
+// Flits are then released to the pool of the partition that ejects
+// them, which need not be the one that allocated them: slots simply
+// migrate between pools, and the in-use counts of single pools can go
+// negative.
+class FlitPool
+{
+  public:
+    FlitPool();
+    ~FlitPool();
+
+    flit *allocFlit(int packet_id, int id, int vc, int vnet,
+                    RouteInfo route, int size, MsgPtr msg_ptr, int MsgSize,
+                    uint32_t bWidth, Tick curTime);
+    Credit *allocCredit(int vc, bool is_free_signal, Tick curTime);
+
+    // Destroy the flit/credit and return its storage to the free list
+    void release(flit *t_flit);
+
+    uint64_t getNumAllocs() const { return m_num_allocs; }
+    uint64_t getNumReuses() const { return m_num_reuses; }
+    int64_t getNumInUse() const { return m_num_in_use; }
+    uint64_t getHighWaterMark() const { return m_high_water_mark; }
+    uint64_t getCapacity() const { return m_chunks.size() * chunkSize; }
+
+    void resetStats();
+
+  private:
+    FlitPool(const FlitPool &obj);
+    FlitPool &operator=(const FlitPool &obj);
+
+    // A Credit is a flit with an extra field, so one slot fits both
+    static_assert(sizeof(Credit) >= sizeof(flit));
+    union Slot
+    {
+        Slot *next;
+        alignas(Credit) unsigned char storage[sizeof(Credit)];
+    };
+
+    static const int chunkSize = 1024;
+
+    void *allocSlot();
+
+    std::vector<std::unique_ptr<Slot[]>> m_chunks;
+    // Released slots
+    Slot *m_free_list;
+    // Never-used slots left at the end of the last chunk
+    int m_num_fresh;
+
+    uint64_t m_num_allocs;
+    uint64_t m_num_reuses;
+    int64_t m_num_in_use;
+    int64_t m_high_water_mark;
+};
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_GARNET_0_FLITPOOL_HH__
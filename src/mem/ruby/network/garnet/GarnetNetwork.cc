@@ -31,10 +31,12 @@
 
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cast.hh"
 #include "base/compiler.hh"
+#include "base/output.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
@@ -55,6 +57,20 @@ namespace ruby
 namespace garnet
 {
 
+namespace
+{
+
+// Percentiles reported for the latency histograms
+const struct
+{
+    double quantile;
+    const char *suffix;
+} latencyQuantiles[] = {
+    {0.5, "p50"}, {0.95, "p95"}, {0.99, "p99"}, {0.999, "p99_9"}
+};
+
+} // anonymous namespace
+
 /*
  * GarnetNetwork sets up the routers and links and collects stats.
  * Default parameters (GarnetNetwork.py) can be overwritten from command line
@@ -73,10 +89,54 @@ GarnetNetwork::GarnetNetwork(const Params &p)
     m_buffers_per_data_vc = p.buffers_per_data_vc;
     m_buffers_per_ctrl_vc = p.buffers_per_ctrl_vc;
     m_routing_algorithm = p.routing_algorithm;
-    m_next_packet_id = 0;
-    m_adaptive_tie_breaking = p.adaptive_tie_breaking;
+    if (p.adaptive_tie_breaking == "x_first") {
+        m_adaptive_tie_breaking = X_FIRST_;
+    } else if (p.adaptive_tie_breaking == "z_first") {
+        m_adaptive_tie_breaking = Z_FIRST_;
+    } else if (p.adaptive_tie_breaking == "uniform") {
+        m_adaptive_tie_breaking = UNIFORM_;
+    } else {
+        warn("Unknown tie-breaking strategy %s, using x_first\n",
+             p.adaptive_tie_breaking);
+        m_adaptive_tie_breaking = X_FIRST_;
+    }
     m_escape_vcs = p.escape_vcs;
     m_distance_coefficient = p.distance_coefficient;
+    if (p.congestion_sensing == "instantaneous") {
+        m_congestion_sensing = INSTANTANEOUS_;
+    } else if (p.congestion_sensing == "ewma") {
+        m_congestion_sensing = EWMA_;
+    } else {
+        warn("Unknown congestion sensing mode %s, using instantaneous\n",
+             p.congestion_sensing);
+        m_congestion_sensing = INSTANTANEOUS_;
+    }
+    fatal_if(p.congestion_ewma_window == 0,
+             "congestion_ewma_window must be at least 1 cycle");
+    m_congestion_ewma_window = p.congestion_ewma_window;
+    m_lookahead_routing = p.lookahead_routing;
+
+    // 2^-6 relative error on the per-vnet percentiles, 2^-4 on the far
+    // more numerous per-pair ones
+    m_packet_network_latency_hist.assign(m_virtual_networks,
+                                         LatencyHistogram(7));
+    m_packet_latency_hist.assign(m_virtual_networks, LatencyHistogram(7));
+    m_flit_network_latency_hist.assign(m_virtual_networks,
+                                       LatencyHistogram(7));
+    m_pair_latency_file = p.pair_latency_file;
+
+    if (p.steady_state_window > 0) {
+        m_steady_state = std::make_unique<SteadyStateMonitor>(
+            this, p.steady_state_window, p.steady_state_tolerance,
+            p.steady_state_warmup_windows, p.steady_state_ci,
+            p.steady_state_min_batches, p.saturation_windows);
+    }
+
+    if (p.telemetry_interval > 0) {
+        m_telemetry = std::make_unique<GarnetTelemetry>(
+            this, p.telemetry_interval, p.telemetry_samples,
+            p.telemetry_file);
+    }
 
     m_enable_fault_model = p.enable_fault_model;
     if (m_enable_fault_model)
@@ -108,6 +168,7 @@ GarnetNetwork::GarnetNetwork(const Params &p)
         m_nis.push_back(ni);
         ni->init_net_ptr(this);
     }
+    m_packet_seqs.assign(m_nis.size(), 0);
 
     // Print Garnet version
     inform("Garnet version %s\n", garnetVersion);
@@ -127,6 +188,17 @@ GarnetNetwork::init()
     assert(m_topology_ptr != NULL);
     m_topology_ptr->createLinks(this);
 
+    // Bridges serialize flits using the pool the flits come from, which
+    // may belong to another partition
+    fatal_if(isPartitioned() && !m_networkbridges.empty(),
+             "%s: clock domain crossings and SerDes are not supported when "
+             "the network is partitioned across event queues.", name());
+
+    // Lookahead routing reads the state of the next router
+    fatal_if(isPartitioned() && m_lookahead_routing,
+             "%s: lookahead routing is not supported when the network is "
+             "partitioned across event queues.", name());
+
     // Initialize topology specific parameters
     if (getNumRows() > 0) {
         // Only for Mesh topology
@@ -158,6 +230,52 @@ GarnetNetwork::init()
     }
 }
 
+void
+GarnetNetwork::startup()
+{
+    Network::startup();
+
+    if (m_steady_state)
+        m_steady_state->start();
+
+    // The input units only exist once all the routers are initialized
+    if (m_telemetry)
+        m_telemetry->start(m_routers);
+}
+
+/*
+ * Flits carry protocol messages, which cannot be checkpointed, so only
+ * a quiescent network is restored exactly. To branch several runs from
+ * one warm network, fork the simulator instead (see
+ * configs/example/garnet_sweep.py --warm-once), which keeps the flits.
+ */
+void
+GarnetNetwork::serialize(CheckpointOut &cp) const
+{
+    ClockedObject::serialize(cp);
+
+    int64_t in_flight = 0;
+    for (auto &pool : m_flit_pools)
+        in_flight += pool.second->getNumInUse();
+    warn_if(in_flight > 0, "%s: %d flits and credits in flight are not "
+            "checkpointed and will be lost on restore\n", name(),
+            in_flight);
+
+    SERIALIZE_CONTAINER(m_packet_seqs);
+}
+
+void
+GarnetNetwork::unserialize(CheckpointIn &cp)
+{
+    ClockedObject::unserialize(cp);
+    if (cp.entryExists(Serializable::currentSection(), "m_packet_seqs")) {
+        UNSERIALIZE_CONTAINER(m_packet_seqs);
+        fatal_if(m_packet_seqs.size() != m_nis.size(), "%s: checkpoint "
+                 "has %d NIs, the network has %d\n", name(),
+                 m_packet_seqs.size(), m_nis.size());
+    }
+}
+
 /*
  * This function creates a link from the Network Interface (NI)
  * into the Network.
@@ -181,8 +299,10 @@ GarnetNetwork::makeExtInLink(NodeID global_src, SwitchID dest, BasicLink* link,
 
     m_networklinks.push_back(net_link);
     m_creditlinks.push_back(credit_link);
+    if (m_telemetry)
+        m_telemetry->addLink(net_link, -1, dest, EXT_IN_, LOCAL_);
 
-    PortDirection dst_inport_dirn = "Local";
+    PortDirectionId dst_inport_dirn = LOCAL_;
 
     m_max_vcs_per_vnet = std::max(m_max_vcs_per_vnet,
                              m_routers[dest]->get_vc_per_vnet());
@@ -254,8 +374,10 @@ GarnetNetwork::makeExtOutLink(SwitchID src, NodeID global_dest,
 
     m_networklinks.push_back(net_link);
     m_creditlinks.push_back(credit_link);
+    if (m_telemetry)
+        m_telemetry->addLink(net_link, src, -1, EXT_OUT_, LOCAL_);
 
-    PortDirection src_outport_dirn = "Local";
+    PortDirectionId src_outport_dirn = LOCAL_;
 
     m_max_vcs_per_vnet = std::max(m_max_vcs_per_vnet,
                              m_routers[src]->get_vc_per_vnet());
@@ -329,6 +451,13 @@ GarnetNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
                              std::max(m_routers[dest]->get_vc_per_vnet(),
                              m_routers[src]->get_vc_per_vnet()));
 
+    // Port direction names are only used to configure the routers
+    PortDirectionId src_outport_id = portDirectionFromName(src_outport_dirn);
+    PortDirectionId dst_inport_id = portDirectionFromName(dst_inport_dirn);
+
+    if (m_telemetry)
+        m_telemetry->addLink(net_link, src, dest, INT_, src_outport_id);
+
     /*
      * We check if a bridge was enabled at any end of the link.
      * The bridge is enabled if either of clock domain
@@ -346,11 +475,11 @@ GarnetNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
         DPRINTF(RubyNetwork, "Enable destination bridge for %s\n",
             garnet_link->name());
         NetworkBridge *n_bridge = garnet_link->dstNetBridge;
-        m_routers[dest]->addInPort(dst_inport_dirn, n_bridge,
+        m_routers[dest]->addInPort(dst_inport_id, n_bridge,
                                    garnet_link->dstCredBridge);
         m_networkbridges.push_back(n_bridge);
     } else {
-        m_routers[dest]->addInPort(dst_inport_dirn, net_link, credit_link);
+        m_routers[dest]->addInPort(dst_inport_id, net_link, credit_link);
     }
 
     if (garnet_link->srcBridgeEn) {
@@ -358,17 +487,46 @@ GarnetNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
             garnet_link->name());
         NetworkBridge *n_bridge = garnet_link->srcNetBridge;
         m_routers[src]->
-            addOutPort(src_outport_dirn, n_bridge,
+            addOutPort(src_outport_id, n_bridge,
                        routing_table_entry,
                        link->m_weight, garnet_link->srcCredBridge,
                        m_routers[dest]->get_vc_per_vnet());
         m_networkbridges.push_back(n_bridge);
     } else {
-        m_routers[src]->addOutPort(src_outport_dirn, net_link,
+        m_routers[src]->addOutPort(src_outport_id, net_link,
                         routing_table_entry,
                         link->m_weight, credit_link,
                         m_routers[dest]->get_vc_per_vnet());
     }
+
+    // Bridges may split flits, so only direct links route ahead
+    if (!garnet_link->srcBridgeEn && !garnet_link->dstBridgeEn) {
+        m_routers[src]->setDownstreamRouter(
+            m_routers[src]->get_num_outports() - 1, m_routers[dest],
+            m_routers[dest]->get_num_inports() - 1, dst_inport_id);
+    }
+}
+
+void
+GarnetNetwork::sample_packet_latency(int vnet, int src_router,
+                                     int dest_router, Tick network_latency,
+                                     Tick queueing_latency)
+{
+    m_packet_network_latency_hist[vnet].sample(network_latency);
+    m_packet_latency_hist[vnet].sample(network_latency + queueing_latency);
+    if (m_steady_state)
+        m_steady_state->packetReceived(network_latency + queueing_latency);
+
+    if (!m_pair_latency_file.empty()) {
+        uint64_t pair = uint64_t(src_router) * m_routers.size() +
+            dest_router;
+        auto it = m_pair_latency_hist.find(pair);
+        if (it == m_pair_latency_hist.end()) {
+            it = m_pair_latency_hist.emplace(pair,
+                                             LatencyHistogram(5)).first;
+        }
+        it->second.sample(network_latency);
+    }
 }
 
 // Total routers in the network
@@ -518,6 +676,15 @@ GarnetNetwork::regStats()
     m_avg_hops.name(name() + ".average_hops");
     m_avg_hops = m_total_hops / sum(m_flits_received);
 
+    m_measured_cycles.name(name() + ".measured_cycles");
+
+    // Tail latency
+    regLatencyPercentiles(m_packet_network_latency_pct,
+                          "packet_network_latency");
+    regLatencyPercentiles(m_packet_latency_pct, "packet_latency");
+    regLatencyPercentiles(m_flit_network_latency_pct,
+                          "flit_network_latency");
+
     // Links
     m_total_ext_in_link_utilization
         .name(name() + ".ext_in_link_utilization");
@@ -554,6 +721,76 @@ GarnetNetwork::regStats()
             m_ctrl_traffic_distribution[source].push_back(ctrl_packets);
         }
     }
+
+    // Flit and credit allocator
+    m_flit_pool_allocs
+        .name(name() + ".flit_pool_allocs");
+    m_flit_pool_reuses
+        .name(name() + ".flit_pool_reuses");
+    m_flit_pool_high_water_mark
+        .name(name() + ".flit_pool_high_water_mark");
+    m_flit_pool_capacity
+        .name(name() + ".flit_pool_capacity");
+    m_flit_pool_reuse_rate
+        .name(name() + ".flit_pool_reuse_rate");
+    m_flit_pool_reuse_rate = m_flit_pool_reuses / m_flit_pool_allocs;
+}
+
+void
+GarnetNetwork::regLatencyPercentiles(statistics::Vector *pct,
+                                     const std::string &latency)
+{
+    static_assert(sizeof(latencyQuantiles) / sizeof(latencyQuantiles[0])
+                  == numLatencyQuantiles, "one stat per quantile");
+
+    for (int q = 0; q < numLatencyQuantiles; q++) {
+        pct[q]
+            .init(m_virtual_networks)
+            .name(name() + "." + latency + "_" +
+                  latencyQuantiles[q].suffix)
+            .flags(statistics::oneline)
+            ;
+        for (int i = 0; i < m_virtual_networks; i++)
+            pct[q].subname(i, csprintf("vnet-%i", i));
+    }
+}
+
+void
+GarnetNetwork::collateLatencyPercentiles(statistics::Vector *pct,
+    const std::vector<LatencyHistogram> &histograms)
+{
+    for (int q = 0; q < numLatencyQuantiles; q++) {
+        for (int i = 0; i < m_virtual_networks; i++) {
+            pct[q][i] =
+                histograms[i].percentile(latencyQuantiles[q].quantile);
+        }
+    }
+}
+
+void
+GarnetNetwork::dumpPairLatencies()
+{
+    OutputStream *file = simout.create(m_pair_latency_file);
+    std::ostream &os = *file->stream();
+    ccprintf(os, "# packet network latency (ticks) per router pair\n");
+    ccprintf(os, "src,dest,packets,p50,p95,p99,p99_9,max\n");
+
+    // Sorted, so that dumps can be compared
+    std::vector<uint64_t> pairs;
+    pairs.reserve(m_pair_latency_hist.size());
+    for (const auto &entry : m_pair_latency_hist)
+        pairs.push_back(entry.first);
+    std::sort(pairs.begin(), pairs.end());
+
+    for (uint64_t pair : pairs) {
+        const LatencyHistogram &hist = m_pair_latency_hist[pair];
+        ccprintf(os, "%d,%d,%d", pair / m_routers.size(),
+                 pair % m_routers.size(), hist.samples());
+        for (const auto &q : latencyQuantiles)
+            ccprintf(os, ",%d", hist.percentile(q.quantile));
+        ccprintf(os, ",%d\n", hist.max());
+    }
+    simout.close(file);
 }
 
 void
@@ -561,6 +798,7 @@ GarnetNetwork::collateStats()
 {
     RubySystem *rs = params().ruby_system;
     double time_delta = double(curCycle() - rs->getStartCycle());
+    m_measured_cycles = time_delta;
 
     for (int i = 0; i < m_networklinks.size(); i++) {
         link_type type = m_networklinks[i]->getType();
@@ -582,10 +820,34 @@ GarnetNetwork::collateStats()
         }
     }
 
+    // With several pools the high water mark is the sum of theirs, an
+    // upper bound of the network-wide one
+    m_flit_pool_allocs = 0;
+    m_flit_pool_reuses = 0;
+    m_flit_pool_high_water_mark = 0;
+    m_flit_pool_capacity = 0;
+    for (auto &pool : m_flit_pools) {
+        m_flit_pool_allocs += pool.second->getNumAllocs();
+        m_flit_pool_reuses += pool.second->getNumReuses();
+        m_flit_pool_high_water_mark += pool.second->getHighWaterMark();
+        m_flit_pool_capacity += pool.second->getCapacity();
+    }
+
     // Ask the routers to collate their statistics
     for (int i = 0; i < m_routers.size(); i++) {
         m_routers[i]->collateStats();
     }
+
+    collateLatencyPercentiles(m_packet_network_latency_pct,
+                              m_packet_network_latency_hist);
+    collateLatencyPercentiles(m_packet_latency_pct, m_packet_latency_hist);
+    collateLatencyPercentiles(m_flit_network_latency_pct,
+                              m_flit_network_latency_hist);
+    if (!m_pair_latency_file.empty())
+        dumpPairLatencies();
+
+    if (m_telemetry)
+        m_telemetry->dump();
 }
 
 void
@@ -600,6 +862,31 @@ GarnetNetwork::resetStats()
     for (int i = 0; i < m_creditlinks.size(); i++) {
         m_creditlinks[i]->resetStats();
     }
+    for (auto &pool : m_flit_pools) {
+        pool.second->resetStats();
+    }
+    for (int i = 0; i < m_virtual_networks; i++) {
+        m_packet_network_latency_hist[i].reset();
+        m_packet_latency_hist[i].reset();
+        m_flit_network_latency_hist[i].reset();
+    }
+    m_pair_latency_hist.clear();
+    if (m_telemetry)
+        m_telemetry->resetCounters();
+}
+
+FlitPool &
+GarnetNetwork::getFlitPool(EventQueue *eventq)
+{
+    for (auto &pool : m_flit_pools) {
+        if (pool.first == eventq)
+            return *pool.second;
+    }
+
+    // Pools are only created while the network is built, before any
+    // thread can allocate from them
+    m_flit_pools.emplace_back(eventq, std::make_unique<FlitPool>());
+    return *m_flit_pools.back().second;
 }
 
 void
@@ -33,11 +33,20 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_GARNETNETWORK_HH__
 
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "mem/ruby/network/Network.hh"
 #include "mem/ruby/network/fault_model/FaultModel.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
+#include "mem/ruby/network/garnet/FlitPool.hh"
+#include "mem/ruby/network/garnet/GarnetTelemetry.hh"
+#include "mem/ruby/network/garnet/LatencyHistogram.hh"
+#include "mem/ruby/network/garnet/SteadyStateMonitor.hh"
 #include "params/GarnetNetwork.hh"
 
 namespace gem5
@@ -66,6 +75,10 @@ class GarnetNetwork : public Network
     ~GarnetNetwork() = default;
 
     void init();
+    void startup() override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
 
     const char *garnetVersion = "3.0";
 
@@ -85,9 +98,24 @@ class GarnetNetwork : public Network
     uint32_t getBuffersPerDataVC() { return m_buffers_per_data_vc; }
     uint32_t getBuffersPerCtrlVC() { return m_buffers_per_ctrl_vc; }
     int getRoutingAlgorithm() const { return m_routing_algorithm; }
-    std::string getAdaptiveTieBreaking() const { return m_adaptive_tie_breaking; }
+    TieBreakingPolicy
+    getAdaptiveTieBreaking() const
+    {
+        return m_adaptive_tie_breaking;
+    }
     uint32_t getEscapeVCs() const { return m_escape_vcs; }
     float getDistanceCoefficient() const { return m_distance_coefficient; }
+    CongestionSensing
+    getCongestionSensing() const
+    {
+        return m_congestion_sensing;
+    }
+    uint32_t
+    getCongestionEwmaWindow() const
+    {
+        return m_congestion_ewma_window;
+    }
+    bool isLookaheadRouting() const { return m_lookahead_routing; }
 
     bool isFaultModelEnabled() const { return m_enable_fault_model; }
     FaultModel* fault_model;
@@ -102,6 +130,13 @@ class GarnetNetwork : public Network
     }
     int getNumRouters();
     int get_router_id(int ni, int vnet);
+    int getNumNIs() const { return m_nis.size(); }
+    NetworkInterface *
+    getNetworkInterface(NodeID local_id)
+    {
+        assert(local_id < m_nis.size());
+        return m_nis[local_id];
+    }
 
 
     // Methods used by Topology to setup the network
@@ -126,7 +161,13 @@ class GarnetNetwork : public Network
     void print(std::ostream& out) const;
 
     // increment counters
-    void increment_injected_packets(int vnet) { m_packets_injected[vnet]++; }
+    void
+    increment_injected_packets(int vnet)
+    {
+        m_packets_injected[vnet]++;
+        if (m_steady_state)
+            m_steady_state->packetInjected();
+    }
     void increment_received_packets(int vnet) { m_packets_received[vnet]++; }
 
     void
@@ -141,7 +182,11 @@ class GarnetNetwork : public Network
         m_packet_queueing_latency[vnet] += latency;
     }
 
-    void increment_injected_flits(int vnet) { m_flits_injected[vnet]++; }
+    void
+    increment_injected_flits(int vnet, int num_flits=1)
+    {
+        m_flits_injected[vnet] += num_flits;
+    }
     void increment_received_flits(int vnet) { m_flits_received[vnet]++; }
 
     void
@@ -162,8 +207,46 @@ class GarnetNetwork : public Network
         m_total_hops += hops;
     }
 
+    // Feed the latency histograms, for the percentile stats
+    void
+    sample_flit_latency(int vnet, Tick network_latency)
+    {
+        m_flit_network_latency_hist[vnet].sample(network_latency);
+    }
+
+    void sample_packet_latency(int vnet, int src_router, int dest_router,
+                               Tick network_latency, Tick queueing_latency);
+
     void update_traffic_distribution(RouteInfo route);
-    int getNextPacketID() { return m_next_packet_id++; }
+
+    // Packet ids are handed out per NI, interleaved across the NIs, so
+    // that they do not depend on the order in which the NIs of different
+    // partitions inject
+    int
+    getNextPacketID(int ni)
+    {
+        assert(ni < m_packet_seqs.size());
+        return m_packet_seqs[ni]++ * m_nis.size() + ni;
+    }
+
+    // Allocator for the flits and credits of the objects running on
+    // eventq. Each event queue gets its own pool, so that partitions
+    // of the network never share a free list.
+    FlitPool &getFlitPool(EventQueue *eventq);
+
+    // The routers and NIs are spread over more than one event queue,
+    // and are simulated by parallel threads.
+    bool isPartitioned() const { return m_flit_pools.size() > 1; }
+
+    // Serialize updates of the network-wide statistics by the NIs
+    // when they run in parallel. Does not lock otherwise.
+    std::unique_lock<std::mutex>
+    lockStats()
+    {
+        if (!isPartitioned())
+            return std::unique_lock<std::mutex>();
+        return std::unique_lock<std::mutex>(m_stats_mutex);
+    }
 
   protected:
     // Configuration
@@ -178,9 +261,12 @@ class GarnetNetwork : public Network
     uint32_t m_buffers_per_data_vc;
     int m_routing_algorithm;
     bool m_enable_fault_model;
-    std::string m_adaptive_tie_breaking;
+    TieBreakingPolicy m_adaptive_tie_breaking;
     uint32_t m_escape_vcs;
     float m_distance_coefficient;
+    CongestionSensing m_congestion_sensing;
+    uint32_t m_congestion_ewma_window;
+    bool m_lookahead_routing;
 
     // Statistical variables
     statistics::Vector m_packets_received;
@@ -214,20 +300,60 @@ class GarnetNetwork : public Network
     statistics::Scalar  m_total_hops;
     statistics::Formula m_avg_hops;
 
+    // Cycles covered by the stats
+    statistics::Scalar m_measured_cycles;
+
+    // Latency percentiles, per vnet, for each of latencyQuantiles
+    static constexpr int numLatencyQuantiles = 4;
+    statistics::Vector m_packet_network_latency_pct[numLatencyQuantiles];
+    statistics::Vector m_packet_latency_pct[numLatencyQuantiles];
+    statistics::Vector m_flit_network_latency_pct[numLatencyQuantiles];
+
     std::vector<std::vector<statistics::Scalar *>> m_data_traffic_distribution;
     std::vector<std::vector<statistics::Scalar *>> m_ctrl_traffic_distribution;
 
+    statistics::Scalar m_flit_pool_allocs;
+    statistics::Scalar m_flit_pool_reuses;
+    statistics::Scalar m_flit_pool_high_water_mark;
+    statistics::Scalar m_flit_pool_capacity;
+    statistics::Formula m_flit_pool_reuse_rate;
+
   private:
     GarnetNetwork(const GarnetNetwork& obj);
     GarnetNetwork& operator=(const GarnetNetwork& obj);
 
+    void regLatencyPercentiles(statistics::Vector *pct,
+                               const std::string &latency);
+    void collateLatencyPercentiles(statistics::Vector *pct,
+        const std::vector<LatencyHistogram> &histograms);
+    void dumpPairLatencies();
+
     std::vector<VNET_type > m_vnet_type;
     std::vector<Router *> m_routers;   // All Routers in Network
     std::vector<NetworkLink *> m_networklinks; // All flit links in the network
     std::vector<NetworkBridge *> m_networkbridges; // All network bridges
     std::vector<CreditLink *> m_creditlinks; // All credit links in the network
     std::vector<NetworkInterface *> m_nis;   // All NI's in Network
-    int m_next_packet_id; // static vairable for packet id allocation
+    std::vector<int> m_packet_seqs; // Packets injected so far, per NI
+    std::vector<std::pair<EventQueue *, std::unique_ptr<FlitPool>>>
+        m_flit_pools;
+    std::mutex m_stats_mutex;
+    // Streaming latency histograms, per vnet
+    std::vector<LatencyHistogram> m_packet_network_latency_hist;
+    std::vector<LatencyHistogram> m_packet_latency_hist;
+    std::vector<LatencyHistogram> m_flit_network_latency_hist;
+
+    // Packet network latency per (source, destination) router pair,
+    // created as the pairs are first seen. Only kept if it is written
+    // to m_pair_latency_file.
+    std::unordered_map<uint64_t, LatencyHistogram> m_pair_latency_hist;
+    std::string m_pair_latency_file;
+
+    // Optional warmup and termination detection
+    std::unique_ptr<SteadyStateMonitor> m_steady_state;
+
+    // Optional time series of the network activity
+    std::unique_ptr<GarnetTelemetry> m_telemetry;
 };
 
 inline std::ostream&
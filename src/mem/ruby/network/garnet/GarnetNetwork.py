@@ -64,6 +64,65 @@ class GarnetNetwork(RubyNetwork):
     distance_coefficient = Param.Float(
         0.0, "distance preference coefficient: negative=prefer short, positive=prefer long, zero=pure congestion"
     )
+    congestion_sensing = Param.String(
+        "instantaneous",
+        "Congestion metric for adaptive routing: instantaneous (current "
+        "output VC occupancy) or ewma (moving average of it)",
+    )
+    congestion_ewma_window = Param.UInt32(
+        8, "window, in cycles, of the ewma congestion metric"
+    )
+    lookahead_routing = Param.Bool(
+        False,
+        "compute the outport of a packet at the next router during switch "
+        "allocation, removing route computation from the router pipeline",
+    )
+    pair_latency_file = Param.String(
+        "",
+        "file, in the output directory, receiving the packet network "
+        "latency percentiles of every pair of routers at each stats dump "
+        "(empty disables the per-pair histograms)",
+    )
+    steady_state_window = Param.Cycles(
+        0,
+        "cycles per window of the steady state detection, which resets "
+        "the stats after warmup and exits once the average packet latency "
+        "converged or the network saturated (0 disables it)",
+    )
+    steady_state_tolerance = Param.Float(
+        0.05,
+        "largest relative difference of the injection and ejection "
+        "rates of a window counted as balanced during warmup",
+    )
+    steady_state_warmup_windows = Param.UInt32(
+        3, "consecutive balanced windows that end the warmup"
+    )
+    steady_state_ci = Param.Float(
+        0.02,
+        "half-width of the 95% confidence interval of the average "
+        "packet latency, relative to it, at which the simulation exits",
+    )
+    steady_state_min_batches = Param.UInt32(
+        10, "windows measured after warmup before checking convergence"
+    )
+    saturation_windows = Param.UInt32(
+        10,
+        "consecutive windows in which the packets in flight grew, and "
+        "at least doubled, after which the network is saturated",
+    )
+    telemetry_interval = Param.Cycles(
+        0,
+        "cycles between two samples of the link, VC and switch "
+        "allocator activity (0 disables the sampler)",
+    )
+    telemetry_samples = Param.UInt32(
+        4096, "samples kept by the telemetry ring buffers"
+    )
+    telemetry_file = Param.String(
+        "garnet_telemetry.bin",
+        "file, in the output directory, the telemetry samples are "
+        "written to at each stats dump",
+    )
 
 
 class GarnetNetworkInterface(ClockedObject):
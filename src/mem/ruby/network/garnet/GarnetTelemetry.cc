@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mem/ruby/network/garnet/GarnetTelemetry.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "mem/ruby/network/garnet/GarnetNetwork.hh"
+#include "mem/ruby/network/garnet/InputUnit.hh"
+#include "mem/ruby/network/garnet/NetworkLink.hh"
+#include "mem/ruby/network/garnet/Router.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+namespace
+{
+
+constexpr uint32_t telemetryVersion = 1;
+
+template <typename T>
+void
+writeColumn(std::ostream &os, const std::vector<T> &ring, size_t row_size,
+            int first, int count, int capacity)
+{
+    // Rows [first, capacity) then [0, first + count - capacity)
+    int head = std::min(count, capacity - first);
+    os.write(reinterpret_cast<const char *>(ring.data() + first * row_size),
+             head * row_size * sizeof(T));
+    os.write(reinterpret_cast<const char *>(ring.data()),
+             (count - head) * row_size * sizeof(T));
+}
+
+uint32_t
+clampCount(uint64_t count)
+{
+    return std::min<uint64_t>(count, std::numeric_limits<uint32_t>::max());
+}
+
+} // anonymous namespace
+
+GarnetTelemetry::GarnetTelemetry(GarnetNetwork *net, Cycles interval,
+                                 int capacity, const std::string &file_name)
+    : m_net(net), m_interval(interval), m_capacity(capacity),
+      m_file_name(file_name),
+      m_event([this]{ sample(); }, net->name() + ".telemetry"),
+      m_num_vcs(0), m_next(0), m_count(0)
+{
+    fatal_if(interval == 0, "%s: the telemetry interval must be at least "
+             "one cycle", net->name());
+    fatal_if(capacity <= 0, "%s: the telemetry rings must hold at least "
+             "one sample", net->name());
+}
+
+void
+GarnetTelemetry::addLink(NetworkLink *link, int src_router, int dest_router,
+                         link_type type, PortDirectionId src_outport)
+{
+    m_links.push_back(link);
+    m_link_info.push_back({src_router, dest_router, int32_t(type),
+                           int32_t(src_outport)});
+}
+
+void
+GarnetTelemetry::start(const std::vector<Router *> &routers)
+{
+    // The sampler reads the state of every router at once
+    fatal_if(m_net->isPartitioned(), "%s: telemetry is not supported when "
+             "the network is partitioned across event queues.",
+             m_net->name());
+
+    m_routers = routers;
+    m_num_vcs = 0;
+    for (Router *router : m_routers)
+        m_num_vcs += router->get_num_inports() * router->get_num_vcs();
+
+    size_t row_bytes = sizeof(uint64_t) +
+        m_links.size() * sizeof(uint32_t) +
+        m_routers.size() * sizeof(uint32_t) + m_num_vcs;
+    inform("%s: sampling every %d cycles into %.1f MB of ring buffers\n",
+           m_net->name(), uint64_t(m_interval),
+           double(row_bytes) * m_capacity / (1 << 20));
+
+    m_ticks.assign(m_capacity, 0);
+    m_link_flits.assign(size_t(m_capacity) * m_links.size(), 0);
+    m_sa_grants.assign(size_t(m_capacity) * m_routers.size(), 0);
+    m_vc_occupancy.assign(size_t(m_capacity) * m_num_vcs, 0);
+    m_last_link_flits.assign(m_links.size(), 0);
+    m_last_sa_grants.assign(m_routers.size(), 0);
+    resetCounters();
+    m_next = 0;
+    m_count = 0;
+
+    m_net->schedule(m_event, m_net->clockEdge(m_interval));
+}
+
+void
+GarnetTelemetry::resetCounters()
+{
+    std::fill(m_last_link_flits.begin(), m_last_link_flits.end(), 0);
+    std::fill(m_last_sa_grants.begin(), m_last_sa_grants.end(), 0);
+}
+
+void
+GarnetTelemetry::sample()
+{
+    m_ticks[m_next] = curTick();
+
+    uint32_t *link_row = &m_link_flits[size_t(m_next) * m_links.size()];
+    for (int i = 0; i < m_links.size(); i++) {
+        uint64_t flits = m_links[i]->getLinkUtilization();
+        link_row[i] = clampCount(flits - m_last_link_flits[i]);
+        m_last_link_flits[i] = flits;
+    }
+
+    uint32_t *sa_row = &m_sa_grants[size_t(m_next) * m_routers.size()];
+    uint8_t *vc_row = &m_vc_occupancy[size_t(m_next) * m_num_vcs];
+    for (int i = 0; i < m_routers.size(); i++) {
+        Router *router = m_routers[i];
+        uint64_t grants = router->get_sa_grants();
+        sa_row[i] = clampCount(grants - m_last_sa_grants[i]);
+        m_last_sa_grants[i] = grants;
+
+        int num_vcs = router->get_num_vcs();
+        for (int inport = 0; inport < router->get_num_inports(); inport++) {
+            InputUnit *input_unit = router->getInputUnit(inport);
+            for (int vc = 0; vc < num_vcs; vc++) {
+                int occupancy = input_unit->get_vc_occupancy(vc);
+                *vc_row++ = std::min(occupancy, 255);
+            }
+        }
+    }
+
+    m_next = (m_next + 1) % m_capacity;
+    m_count = std::min(m_count + 1, m_capacity);
+
+    m_net->schedule(m_event, m_net->clockEdge(m_interval));
+}
+
+void
+GarnetTelemetry::dump()
+{
+    GarnetTelemetryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "GNTELEM", 8);
+    header.version = telemetryVersion;
+    header.interval = uint64_t(m_interval);
+    header.clockPeriod = m_net->clockPeriod();
+    header.numSamples = m_count;
+    header.numLinks = m_links.size();
+    header.numRouters = m_routers.size();
+    header.numVCs = m_num_vcs;
+    header.torusX = m_net->getTorusX();
+    header.torusY = m_net->getTorusY();
+    header.torusZ = m_net->getTorusZ();
+
+    OutputStream *file = simout.create(m_file_name, true);
+    std::ostream &os = *file->stream();
+    os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    os.write(reinterpret_cast<const char *>(m_link_info.data()),
+             m_link_info.size() * sizeof(GarnetTelemetryLink));
+    for (Router *router : m_routers) {
+        GarnetTelemetryRouter info;
+        info.numInports = router->get_num_inports();
+        info.vcsPerInport = router->get_num_vcs();
+        os.write(reinterpret_cast<const char *>(&info), sizeof(info));
+    }
+
+    int first = (m_next - m_count + m_capacity) % m_capacity;
+    writeColumn(os, m_ticks, 1, first, m_count, m_capacity);
+    writeColumn(os, m_link_flits, m_links.size(), first, m_count,
+                m_capacity);
+    writeColumn(os, m_sa_grants, m_routers.size(), first, m_count,
+                m_capacity);
+    writeColumn(os, m_vc_occupancy, m_num_vcs, first, m_count, m_capacity);
+
+    if (!os)
+        warn("%s: could not write %s\n", m_net->name(), m_file_name);
+    simout.close(file);
+}
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_RUBY_NETWORK_GARNET_0_GARNETTELEMETRY_HH__
+#define __MEM_RUBY_NETWORK_GARNET_0_GARNETTELEMETRY_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/ruby/network/garnet/CommonTypes.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+class GarnetNetwork;
+class NetworkLink;
+class Router;
+
+// Layout of the telemetry file, in host byte order. The header is
+// followed by numLinks link descriptors, numRouters router
+// descriptors and then the samples, oldest first, one column at a
+// time: the sample ticks (uint64_t), the flits carried by each link
+// during each interval (uint32_t [numSamples][numLinks]), the switch
+// allocator grants of each router (uint32_t [numSamples][numRouters])
+// and the flits buffered in each input VC at the end of the interval
+// (uint8_t [numSamples][numVCs], saturating). The VCs are numbered
+// router by router, inport by inport.
+struct GarnetTelemetryHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t interval;      // cycles between two samples
+    uint64_t clockPeriod;   // ticks per network cycle
+    uint32_t numSamples;
+    uint32_t numLinks;
+    uint32_t numRouters;
+    uint32_t numVCs;
+    int32_t torusX;
+    int32_t torusY;
+    int32_t torusZ;
+    uint32_t reserved;
+};
+
+struct GarnetTelemetryLink
+{
+    int32_t srcRouter;      // -1 for a link from a NI
+    int32_t destRouter;     // -1 for a link to a NI
+    int32_t type;           // link_type
+    int32_t srcOutport;     // PortDirectionId at the source router
+};
+
+struct GarnetTelemetryRouter
+{
+    uint32_t numInports;
+    uint32_t vcsPerInport;
+};
+
+static_assert(sizeof(GarnetTelemetryHeader) == 56, "unexpected padding");
+
+// Samples the link utilization, input VC occupancy and switch
+// allocator grants of a GarnetNetwork every few cycles. The samples
+// are kept in ring buffers allocated when the simulation starts, so
+// that sampling never allocates, and written out at each stats dump.
+// Only the newest samples survive once the rings have wrapped.
+class GarnetTelemetry
+{
+  public:
+    GarnetTelemetry(GarnetNetwork *net, Cycles interval, int capacity,
+                    const std::string &file_name);
+
+    // Called while the network is built, for each flit link
+    void addLink(NetworkLink *link, int src_router, int dest_router,
+                 link_type type, PortDirectionId src_outport);
+
+    // Size the rings and schedule the first sample
+    void start(const std::vector<Router *> &routers);
+
+    // The link and router counters went back to zero
+    void resetCounters();
+
+    // Overwrite the output file with the samples taken so far
+    void dump();
+
+  private:
+    void sample();
+
+    GarnetNetwork *m_net;
+    Cycles m_interval;
+    int m_capacity;
+    std::string m_file_name;
+    EventFunctionWrapper m_event;
+
+    std::vector<NetworkLink *> m_links;
+    std::vector<GarnetTelemetryLink> m_link_info;
+    std::vector<Router *> m_routers;
+    int m_num_vcs;
+
+    // Counter values at the previous sample
+    std::vector<uint64_t> m_last_link_flits;
+    std::vector<uint64_t> m_last_sa_grants;
+
+    // Ring buffers, one row per sample
+    std::vector<uint64_t> m_ticks;
+    std::vector<uint32_t> m_link_flits;
+    std::vector<uint32_t> m_sa_grants;
+    std::vector<uint8_t> m_vc_occupancy;
+    int m_next;     // row of the next sample
+    int m_count;    // valid rows
+};
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_GARNET_0_GARNETTELEMETRY_HH__
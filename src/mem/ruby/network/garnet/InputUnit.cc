@@ -44,9 +44,10 @@ namespace ruby
 namespace garnet
 {
 
-InputUnit::InputUnit(int id, PortDirection direction, Router *router)
+InputUnit::InputUnit(int id, PortDirectionId direction, Router *router)
   : Consumer(router), m_router(router), m_id(id), m_direction(direction),
-    m_vc_per_vnet(m_router->get_vc_per_vnet())
+    m_vc_per_vnet(m_router->get_vc_per_vnet()), m_occupied_vcs(0),
+    m_routed_ahead_vcs(0)
 {
     const int m_num_vcs = m_router->get_num_vcs();
     m_num_buffer_reads.resize(m_num_vcs/m_vc_per_vnet);
@@ -57,9 +58,15 @@ InputUnit::InputUnit(int id, PortDirection direction, Router *router)
     }
 
     // Instantiating the virtual channels
+    // Credits bound the occupancy of each VC to its number of buffers
+    GarnetNetwork *net_ptr = m_router->get_net_ptr();
     virtualChannels.reserve(m_num_vcs);
     for (int i=0; i < m_num_vcs; i++) {
-        virtualChannels.emplace_back();
+        int vnet = i / m_vc_per_vnet;
+        if (net_ptr->get_vnet_type(vnet) == DATA_VNET_)
+            virtualChannels.emplace_back(net_ptr->getBuffersPerDataVC());
+        else
+            virtualChannels.emplace_back(net_ptr->getBuffersPerCtrlVC());
     }
 }
 
@@ -86,7 +93,6 @@ InputUnit::wakeup()
         assert(t_flit->m_width == m_router->getBitWidth());
         int vc = t_flit->get_vc();
         t_flit->increment_hops(); // for stats
-
         if ((t_flit->get_type() == HEAD_) ||
             (t_flit->get_type() == HEAD_TAIL_)) {
 
@@ -95,9 +101,17 @@ InputUnit::wakeup()
             // printf("[InputUnit Debug] Router %d: HEAD flit sets VC %d to ACTIVE, type=%d\n", 
             //        m_router->get_id(), vc, t_flit->get_type());
 
-            // Route computation for this vc
-            int outport = m_router->route_compute(t_flit->get_route(),
-                m_id, m_direction, t_flit);
+            // Route computation for this vc, unless the previous router
+            // did it. With lookahead routing, only the heads entering the
+            // network here or through a bridge still go through it.
+            int outport = t_flit->get_lookahead_outport();
+            if (outport == -1) {
+                outport = m_router->route_compute(t_flit->get_route(),
+                    m_id, m_direction, t_flit);
+                m_routed_ahead_vcs &= ~(1ULL << vc);
+            } else {
+                m_routed_ahead_vcs |= 1ULL << vc;
+            }
 
             // Update output port in VC
             // All flits in this packet will use this output port
@@ -118,6 +132,8 @@ InputUnit::wakeup()
 
         // Buffer the flit
         virtualChannels[vc].insertFlit(t_flit);
+        m_occupied_vcs |= 1ULL << vc;
+        m_router->setInportOccupied(m_id);
 
         int vnet = vc/m_vc_per_vnet;
         // number of writes same as reads
@@ -126,6 +142,10 @@ InputUnit::wakeup()
         m_num_buffer_reads[vnet]++;
 
         Cycles pipe_stages = m_router->get_pipe_stages();
+        // The flits of a packet routed ahead skip route computation and
+        // save a pipeline stage; the others keep the full pipeline
+        if ((m_routed_ahead_vcs & (1ULL << vc)) && pipe_stages > 1)
+            pipe_stages = pipe_stages - Cycles(1);
         if (pipe_stages == 1) {
             // 1-cycle router
             // Flit goes for SA directly
@@ -155,7 +175,8 @@ InputUnit::increment_credit(int in_vc, bool free_signal, Tick curTime)
 {
     DPRINTF(RubyNetwork, "Router[%d]: Sending a credit vc:%d free:%d to %s\n",
     m_router->get_id(), in_vc, free_signal, m_credit_link->name());
-    Credit *t_credit = new Credit(in_vc, free_signal, curTime);
+    Credit *t_credit = m_router->getFlitPool().allocCredit(in_vc, free_signal,
+                                                           curTime);
     creditQueue.insert(t_credit);
     m_credit_link->scheduleEventAbsolute(m_router->clockEdge(Cycles(1)));
 }
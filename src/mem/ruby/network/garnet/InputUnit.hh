@@ -55,13 +55,13 @@ namespace garnet
 class InputUnit : public Consumer
 {
   public:
-    InputUnit(int id, PortDirection direction, Router *router);
+    InputUnit(int id, PortDirectionId direction, Router *router);
     ~InputUnit() = default;
 
     void wakeup();
     void print(std::ostream& out) const {};
 
-    inline PortDirection get_direction() { return m_direction; }
+    inline PortDirectionId get_direction() { return m_direction; }
 
     inline void
     set_vc_idle(int vc, Tick curTime)
@@ -118,9 +118,18 @@ class InputUnit : public Consumer
     inline flit*
     getTopFlit(int vc)
     {
-        return virtualChannels[vc].getTopFlit();
+        flit *t_flit = virtualChannels[vc].getTopFlit();
+        if (virtualChannels[vc].isEmpty()) {
+            m_occupied_vcs &= ~(1ULL << vc);
+            if (m_occupied_vcs == 0)
+                m_router->clearInportOccupied(m_id);
+        }
+        return t_flit;
     }
 
+    // Bitmask of the VCs holding at least one flit
+    uint64_t getOccupiedVcs() const { return m_occupied_vcs; }
+
     inline bool
     need_stage(int vc, flit_stage stage, Tick time)
     {
@@ -133,6 +142,13 @@ class InputUnit : public Consumer
         return virtualChannels[invc].isReady(curTime);
     }
 
+    // Flits buffered in the VC
+    inline int
+    get_vc_occupancy(int vc) const
+    {
+        return virtualChannels[vc].get_occupancy();
+    }
+
     flitBuffer* getCreditQueue() { return &creditQueue; }
 
     inline void
@@ -142,6 +158,7 @@ class InputUnit : public Consumer
     }
 
     inline int get_inlink_id() { return m_in_link->get_id(); }
+    inline NetworkLink *get_in_link() { return m_in_link; }
 
     inline void
     set_credit_link(CreditLink *credit_link)
@@ -162,7 +179,7 @@ class InputUnit : public Consumer
   private:
     Router *m_router;
     int m_id;
-    PortDirection m_direction;
+    PortDirectionId m_direction;
     int m_vc_per_vnet;
     NetworkLink *m_in_link;
     CreditLink *m_credit_link;
@@ -170,6 +187,10 @@ class InputUnit : public Consumer
 
     // Input Virtual channels
     std::vector<VirtualChannel> virtualChannels;
+    uint64_t m_occupied_vcs;
+    // VCs whose current packet had its route computed by the previous
+    // router (lookahead routing)
+    uint64_t m_routed_ahead_vcs;
 
     // Statistical variables
     std::vector<double> m_num_buffer_writes;
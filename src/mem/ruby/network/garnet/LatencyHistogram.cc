@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mem/ruby/network/garnet/LatencyHistogram.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+uint64_t
+LatencyHistogram::percentile(double q) const
+{
+    if (m_samples == 0)
+        return 0;
+
+    // Rank of the sample we are looking for, counting from 1
+    uint64_t rank = std::ceil(q * m_samples);
+    rank = std::min(std::max<uint64_t>(rank, 1), m_samples);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < m_counts.size(); i++) {
+        seen += m_counts[i];
+        if (seen >= rank)
+            return std::min(bucketEnd(i), m_max);
+    }
+    return m_max;
+}
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_RUBY_NETWORK_GARNET_0_LATENCYHISTOGRAM_HH__
+#define __MEM_RUBY_NETWORK_GARNET_0_LATENCYHISTOGRAM_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+// Streaming histogram of latencies with log-linear buckets, in the
+// style of HdrHistogram. Values below 2^subBucketBits get a bucket of
+// their own; above, every power of two is split into
+// 2^(subBucketBits - 1) buckets, so that a percentile is reported
+// within a relative error of 2^(1 - subBucketBits). The buckets are
+// allocated up to the largest value seen, which bounds the memory of a
+// histogram by (66 - subBucketBits) * 2^(subBucketBits - 1) counters
+// whatever the number of samples.
+class LatencyHistogram
+{
+  public:
+    explicit LatencyHistogram(int sub_bucket_bits = 5)
+        : m_sub_bits(sub_bucket_bits),
+          m_half(uint64_t(1) << (sub_bucket_bits - 1)),
+          m_samples(0), m_max(0)
+    {}
+
+    void
+    sample(uint64_t value)
+    {
+        size_t index = bucketIndex(value);
+        if (index >= m_counts.size())
+            m_counts.resize(index + 1, 0);
+        m_counts[index]++;
+        m_samples++;
+        if (value > m_max)
+            m_max = value;
+    }
+
+    // Value below which a fraction q of the samples fall, rounded up to
+    // the end of its bucket (and never above the largest sample). 0 if
+    // the histogram is empty.
+    uint64_t percentile(double q) const;
+
+    uint64_t samples() const { return m_samples; }
+    uint64_t max() const { return m_max; }
+
+    void
+    reset()
+    {
+        m_counts.clear();
+        m_samples = 0;
+        m_max = 0;
+    }
+
+  private:
+    size_t
+    bucketIndex(uint64_t value) const
+    {
+        if (value < 2 * m_half)
+            return value;
+        // Keep the subBucketBits most significant bits of the value
+        int shift = floorLog2(value) - m_sub_bits + 1;
+        return shift * m_half + (value >> shift);
+    }
+
+    uint64_t
+    bucketEnd(size_t index) const
+    {
+        if (index < 2 * m_half)
+            return index;
+        int shift = index / m_half - 1;
+        uint64_t mantissa = index - shift * m_half;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+    int m_sub_bits;
+    uint64_t m_half;
+    std::vector<uint64_t> m_counts;
+    uint64_t m_samples;
+    uint64_t m_max;
+};
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_GARNET_0_LATENCYHISTOGRAM_HH__
@@ -35,6 +35,7 @@
 #include <cmath>
 
 #include "debug/RubyNetwork.hh"
+#include "mem/ruby/network/garnet/FlitPool.hh"
 #include "params/GarnetIntLink.hh"
 
 namespace gem5
@@ -112,6 +113,7 @@ NetworkBridge::scheduleFlit(flit *t_flit, Cycles latency)
     t_flit->set_time(sendTime);
     lastScheduledAt = sendTime;
     linkBuffer.insert(t_flit);
+    markConsumerPort();
     link_consumer->scheduleEventAbsolute(sendTime);
 }
 
@@ -200,8 +202,8 @@ NetworkBridge::flitisizeAndSend(flit *t_flit)
                 lenBuffer[vc] = 0;
                 scheduleFlit(fl, serDesLatency);
             }
-            // Delete this flit, new flit is sent in any case
-            delete t_flit;
+            // Release this flit, new flit is sent in any case
+            t_flit->get_pool()->release(t_flit);
         } else {
             // Serialize
             DPRINTF(RubyNetwork, "Serializing flit :%d -----> %d "
@@ -246,8 +248,8 @@ NetworkBridge::flitisizeAndSend(flit *t_flit)
             if (t_flit->get_type() != CREDIT_) {
                 coBridge->neutralize(vc, flitPossible);
             }
-            // Delete this flit, new flit is sent in any case
-            delete t_flit;
+            // Release this flit, new flit is sent in any case
+            t_flit->get_pool()->release(t_flit);
         }
         return;
     }
@@ -39,6 +39,7 @@
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
 #include "mem/ruby/network/garnet/Credit.hh"
+#include "mem/ruby/network/garnet/SyntheticMessage.hh"
 #include "mem/ruby/network/garnet/flitBuffer.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 
@@ -56,6 +57,7 @@ NetworkInterface::NetworkInterface(const Params &p)
     m_virtual_networks(p.virt_nets), m_vc_per_vnet(0),
     m_vc_allocator(m_virtual_networks, 0),
     m_deadlock_threshold(p.garnet_deadlock_threshold),
+    m_synthetic(false),
     vc_busy_counter(m_virtual_networks, 0)
 {
     m_stall_count.resize(m_virtual_networks);
@@ -154,6 +156,8 @@ void
 NetworkInterface::incrementStats(flit *t_flit)
 {
     int vnet = t_flit->get_vnet();
+    const RouteInfo &route = t_flit->get_route();
+    auto stats_lock = m_net_ptr->lockStats();
 
     // Latency
     m_net_ptr->increment_received_flits(vnet);
@@ -166,15 +170,19 @@ NetworkInterface::incrementStats(flit *t_flit)
 
     m_net_ptr->increment_flit_network_latency(network_delay, vnet);
     m_net_ptr->increment_flit_queueing_latency(queueing_delay, vnet);
+    m_net_ptr->sample_flit_latency(vnet, network_delay);
 
     if (t_flit->get_type() == TAIL_ || t_flit->get_type() == HEAD_TAIL_) {
         m_net_ptr->increment_received_packets(vnet);
         m_net_ptr->increment_packet_network_latency(network_delay, vnet);
         m_net_ptr->increment_packet_queueing_latency(queueing_delay, vnet);
+        m_net_ptr->sample_packet_latency(vnet, route.src_router,
+                                         route.dest_router, network_delay,
+                                         queueing_delay);
     }
 
     // Hops
-    m_net_ptr->increment_total_hops(t_flit->get_route().hops_traversed);
+    m_net_ptr->increment_total_hops(route.hops_traversed);
 }
 
 /*
@@ -237,10 +245,18 @@ NetworkInterface::wakeup()
 
             // If a tail flit is received, enqueue into the protocol buffers
             // if space is available. Otherwise, exchange non-tail flits for
-            // credits.
+            // credits. Synthetic packets are dropped once their client knows.
             if (t_flit->get_type() == TAIL_ ||
                 t_flit->get_type() == HEAD_TAIL_) {
-                if (!iPort->messageEnqueuedThisCycle &&
+                if (m_synthetic) {
+                    std::static_pointer_cast<SyntheticMessage>(
+                        t_flit->get_msg_ptr())->delivered();
+                    Credit *cFlit = m_flit_pool->allocCredit(
+                        t_flit->get_vc(), true, curTick());
+                    iPort->sendCredit(cFlit);
+                    incrementStats(t_flit);
+                    m_flit_pool->release(t_flit);
+                } else if (!iPort->messageEnqueuedThisCycle &&
                     outNode_ptr[vnet]->areNSlotsAvailable(1, curTime)) {
                     // Space is available. Enqueue to protocol buffer.
                     outNode_ptr[vnet]->enqueue(t_flit->get_msg_ptr(), curTime,
@@ -248,12 +264,12 @@ NetworkInterface::wakeup()
 
                     // Simply send a credit back since we are not buffering
                     // this flit in the NI
-                    Credit *cFlit = new Credit(t_flit->get_vc(),
-                                               true, curTick());
+                    Credit *cFlit = m_flit_pool->allocCredit(
+                        t_flit->get_vc(), true, curTick());
                     iPort->sendCredit(cFlit);
                     // Update stats and delete flit pointer
                     incrementStats(t_flit);
-                    delete t_flit;
+                    m_flit_pool->release(t_flit);
                 } else {
                     // No space available- Place tail flit in stall queue and
                     // set up a callback for when protocol buffer is dequeued.
@@ -267,15 +283,15 @@ NetworkInterface::wakeup()
                 }
             } else {
                 // Non-tail flit. Send back a credit but not VC free signal.
-                Credit *cFlit = new Credit(t_flit->get_vc(), false,
-                                               curTick());
+                Credit *cFlit = m_flit_pool->allocCredit(
+                    t_flit->get_vc(), false, curTick());
                 // Simply send a credit back since we are not buffering
                 // this flit in the NI
                 iPort->sendCredit(cFlit);
 
                 // Update stats and delete flit pointer.
                 incrementStats(t_flit);
-                delete t_flit;
+                m_flit_pool->release(t_flit);
             }
         }
     }
@@ -291,7 +307,7 @@ NetworkInterface::wakeup()
                 outVcState[t_credit->get_vc()].setState(IDLE_,
                     curTick());
             }
-            delete t_credit;
+            m_flit_pool->release(t_credit);
         }
     }
 
@@ -336,8 +352,8 @@ NetworkInterface::checkStallQueue()
 
                     // Send back a credit with free signal now that the
                     // VC is no longer stalled.
-                    Credit *cFlit = new Credit(stallFlit->get_vc(), true,
-                                                   curTick());
+                    Credit *cFlit = m_flit_pool->allocCredit(
+                        stallFlit->get_vc(), true, curTick());
                     iPort->sendCredit(cFlit);
 
                     // Update Stats
@@ -345,7 +361,7 @@ NetworkInterface::checkStallQueue()
 
                     // Flit can now safely be deleted and removed from stall
                     // queue
-                    delete stallFlit;
+                    m_flit_pool->release(stallFlit);
                     iPort->m_stall_queue.erase(stallIter);
                     m_stall_count[vnet]--;
 
@@ -372,18 +388,29 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
     NetDest net_msg_dest = net_msg_ptr->getDestination();
 
     // gets all the destinations associated with this message.
-    std::vector<NodeID> dest_nodes = net_msg_dest.getAllDest();
+    std::vector<NodeID> dest_nodes;
+    int msg_size;
+    if (m_synthetic) {
+        // Unicast with an explicit size; no need to decode the NetDest
+        auto *syn_msg_ptr = dynamic_cast<SyntheticMessage *>(net_msg_ptr);
+        panic_if(!syn_msg_ptr, "%s: non-synthetic message %s injected "
+                 "with synthetic traffic\n", name(), *net_msg_ptr);
+        dest_nodes.push_back(syn_msg_ptr->getDestNode());
+        msg_size = syn_msg_ptr->getSize();
+    } else {
+        dest_nodes = net_msg_dest.getAllDest();
+        msg_size = m_net_ptr->MessageSizeType_to_int(
+            net_msg_ptr->getMessageSize());
+    }
 
     // Number of flits is dependent on the link bandwidth available.
     // This is expressed in terms of bytes/cycle or the flit size
     OutputPort *oPort = getOutportForVnet(vnet);
     assert(oPort);
-    int num_flits = (int)divCeil((float) m_net_ptr->MessageSizeType_to_int(
-        net_msg_ptr->getMessageSize()), (float)oPort->bitWidth());
+    int num_flits = (int)divCeil((float) msg_size, (float)oPort->bitWidth());
 
     DPRINTF(RubyNetwork, "Message Size:%d vnet:%d bitWidth:%d\n",
-        m_net_ptr->MessageSizeType_to_int(net_msg_ptr->getMessageSize()),
-        vnet, oPort->bitWidth());
+        msg_size, vnet, oPort->bitWidth());
 
     // loop to convert all multicast messages into unicast messages
     for (int ctr = 0; ctr < dest_nodes.size(); ctr++) {
@@ -394,7 +421,9 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         if (vc == -1) {
             return false ;
         }
-        MsgPtr new_msg_ptr = msg_ptr->clone();
+        // Synthetic messages are never modified, so the flits can share
+        // the injected one
+        MsgPtr new_msg_ptr = m_synthetic ? msg_ptr : msg_ptr->clone();
         NodeID destID = dest_nodes[ctr];
 
         Message *new_net_msg_ptr = new_msg_ptr.get();
@@ -434,15 +463,16 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         // so that the first router increments it to 0
         route.hops_traversed = -1;
 
-        m_net_ptr->increment_injected_packets(vnet);
-        m_net_ptr->update_traffic_distribution(route);
-        int packet_id = m_net_ptr->getNextPacketID();
+        {
+            auto stats_lock = m_net_ptr->lockStats();
+            m_net_ptr->increment_injected_packets(vnet);
+            m_net_ptr->increment_injected_flits(vnet, num_flits);
+            m_net_ptr->update_traffic_distribution(route);
+        }
+        int packet_id = m_net_ptr->getNextPacketID(m_id);
         for (int i = 0; i < num_flits; i++) {
-            m_net_ptr->increment_injected_flits(vnet);
-            flit *fl = new flit(packet_id,
-                i, vc, vnet, route, num_flits, new_msg_ptr,
-                m_net_ptr->MessageSizeType_to_int(
-                net_msg_ptr->getMessageSize()),
+            flit *fl = m_flit_pool->allocFlit(packet_id,
+                i, vc, vnet, route, num_flits, new_msg_ptr, msg_size,
                 oPort->bitWidth(), curTick());
 
             fl->set_src_delay(curTick() - msg_ptr->getTime());
@@ -77,11 +77,27 @@ class NetworkInterface : public ClockedObject, public Consumer
 
     void print(std::ostream& out) const;
     int get_vnet(int vc);
-    void init_net_ptr(GarnetNetwork *net_ptr) { m_net_ptr = net_ptr; }
+    void
+    init_net_ptr(GarnetNetwork *net_ptr)
+    {
+        m_net_ptr = net_ptr;
+        m_flit_pool = &net_ptr->getFlitPool(eventQueue());
+    }
 
     bool functionalRead(Packet *pkt, WriteMask &mask);
     uint32_t functionalWrite(Packet *);
 
+    // Protocol buffer that feeds vnet into the network, if any
+    MessageBuffer *
+    getInNode(int vnet) const
+    {
+        return vnet < inNode_ptr.size() ? inNode_ptr[vnet] : nullptr;
+    }
+
+    // Take SyntheticMessages from the protocol buffers and drop packets
+    // on ejection instead of handing them to the protocol
+    void setSyntheticTraffic() { m_synthetic = true; }
+
     void scheduleFlit(flit *t_flit);
 
     int get_router_id(int vnet)
@@ -270,6 +286,7 @@ class NetworkInterface : public ClockedObject, public Consumer
 
   private:
     GarnetNetwork *m_net_ptr;
+    FlitPool *m_flit_pool;
     const NodeID m_id;
     const int m_virtual_networks;
     int m_vc_per_vnet;
@@ -278,6 +295,7 @@ class NetworkInterface : public ClockedObject, public Consumer
     std::vector<InputPort *> inPorts;
     int m_deadlock_threshold;
     std::vector<OutVcState> outVcState;
+    bool m_synthetic;
 
     std::vector<int> m_stall_count;
 
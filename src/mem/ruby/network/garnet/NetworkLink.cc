@@ -50,7 +50,9 @@ NetworkLink::NetworkLink(const Params &p)
       m_type(NUM_LINK_TYPES_),
       m_latency(p.link_latency), m_link_utilized(0),
       m_virt_nets(p.virt_nets), linkBuffer(),
-      link_consumer(nullptr), link_srcQueue(nullptr)
+      link_consumer(nullptr), link_srcQueue(nullptr),
+      m_consumer_pending_ports(nullptr), m_consumer_port_bit(0),
+      m_consumer_eventq(nullptr)
 {
     int num_vnets = (p.supported_vnets).size();
     mVnets.resize(num_vnets);
@@ -64,6 +66,29 @@ void
 NetworkLink::setLinkConsumer(Consumer *consumer)
 {
     link_consumer = consumer;
+
+    // A link is driven by its source, so it runs on the source's event
+    // queue. If the consumer runs on another one, the link latency is
+    // the lookahead between the two: every flit must arrive after the
+    // end of the quantum it was sent in.
+    EventQueue *consumer_eventq = consumer->getObject()->eventQueue();
+    if (consumer_eventq != eventQueue()) {
+        fatal_if(cyclesToTicks(m_latency) < simQuantum,
+                 "%s connects two event queues, so its latency (%d ticks) "
+                 "must be at least the simulation quantum (%d ticks).",
+                 name(), cyclesToTicks(m_latency), simQuantum);
+        m_consumer_eventq = consumer_eventq;
+    } else {
+        m_consumer_eventq = nullptr;
+    }
+}
+
+void
+NetworkLink::setConsumerPort(uint64_t *pending_ports, int port)
+{
+    assert(port < 64);
+    m_consumer_pending_ports = pending_ports;
+    m_consumer_port_bit = 1ULL << port;
 }
 
 void
@@ -98,8 +123,16 @@ NetworkLink::wakeup()
                 (mVnets.size() == 0));
         }
         t_flit->set_time(clockEdge(m_latency));
-        linkBuffer.insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        if (m_consumer_eventq) {
+            // The consumer's state belongs to another thread; hand the
+            // flit over on the consumer's queue
+            m_consumer_eventq->schedule(new DeliveryEvent(this, t_flit),
+                                        clockEdge(m_latency));
+        } else {
+            linkBuffer.insert(t_flit);
+            markConsumerPort();
+            link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        }
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
     }
@@ -109,6 +142,15 @@ NetworkLink::wakeup()
     }
 }
 
+// Runs on the consumer's event queue, in the cycle the flit arrives
+void
+NetworkLink::deliverFlit(flit *t_flit)
+{
+    linkBuffer.insert(t_flit);
+    markConsumerPort();
+    link_consumer->scheduleEventAbsolute(curTick());
+}
+
 void
 NetworkLink::resetStats()
 {
@@ -61,6 +61,9 @@ class NetworkLink : public ClockedObject, public Consumer
     ~NetworkLink() = default;
 
     void setLinkConsumer(Consumer *consumer);
+    // Set bit port of *pending_ports whenever a flit is sent to the
+    // consumer, so a router can tell which of its ports has work
+    void setConsumerPort(uint64_t *pending_ports, int port);
     void setSourceQueue(flitBuffer *src_queue, ClockedObject *srcClockObject);
     virtual void setVcsPerVnet(uint32_t consumerVcs);
     void setType(link_type type) { m_type = type; }
@@ -89,6 +92,27 @@ class NetworkLink : public ClockedObject, public Consumer
     uint32_t bitWidth;
 
   private:
+    // Hands a flit over to a consumer that runs on another event queue.
+    // Scheduled on the consumer's queue for the cycle the flit arrives,
+    // ahead of the consumer's own wakeup in that cycle.
+    class DeliveryEvent : public Event
+    {
+      public:
+        DeliveryEvent(NetworkLink *link, flit *t_flit)
+            : Event(Default_Pri - 1, AutoDelete), m_link(link),
+              m_flit(t_flit)
+        {}
+
+        void process() override { m_link->deliverFlit(m_flit); }
+        const char *description() const override { return "link delivery"; }
+
+      private:
+        NetworkLink *m_link;
+        flit *m_flit;
+    };
+
+    void deliverFlit(flit *t_flit);
+
     const int m_id;
     link_type m_type;
     const Cycles m_latency;
@@ -100,10 +124,22 @@ class NetworkLink : public ClockedObject, public Consumer
     std::vector<unsigned int> m_vc_load;
 
   protected:
+    inline void
+    markConsumerPort()
+    {
+        if (m_consumer_pending_ports)
+            *m_consumer_pending_ports |= m_consumer_port_bit;
+    }
+
     uint32_t m_virt_nets;
     flitBuffer linkBuffer;
     Consumer *link_consumer;
     flitBuffer *link_srcQueue;
+    uint64_t *m_consumer_pending_ports;
+    uint64_t m_consumer_port_bit;
+    // Event queue of the consumer if it is not the link's own, i.e. if
+    // the link connects two partitions of the network
+    EventQueue *m_consumer_eventq;
 
 };
 
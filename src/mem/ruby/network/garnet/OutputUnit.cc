@@ -31,6 +31,9 @@
 
 #include "mem/ruby/network/garnet/OutputUnit.hh"
 
+#include <algorithm>
+#include <cmath>
+
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/Credit.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
@@ -47,16 +50,62 @@ namespace ruby
 namespace garnet
 {
 
-OutputUnit::OutputUnit(int id, PortDirection direction, Router *router,
+OutputUnit::OutputUnit(int id, PortDirectionId direction, Router *router,
   uint32_t consumerVcs)
   : Consumer(router), m_router(router), m_id(id), m_direction(direction),
     m_vc_per_vnet(consumerVcs)
 {
+    fatal_if(consumerVcs > 64, "Router%d: at most 64 VCs per vnet are "
+             "supported, got %d.", m_router->get_id(), consumerVcs);
+
     const int m_num_vcs = consumerVcs * m_router->get_num_vnets();
     outVcState.reserve(m_num_vcs);
     for (int i = 0; i < m_num_vcs; i++) {
         outVcState.emplace_back(i, m_router->get_net_ptr(), consumerVcs);
     }
+
+    // All VCs start idle with a full set of credits
+    m_free_vcs.assign(m_router->get_num_vnets(), mask(m_vc_per_vnet));
+    m_credit_vcs.assign(m_router->get_num_vnets(), mask(m_vc_per_vnet));
+
+    uint32_t escape_vcs = std::min<uint32_t>(
+        m_router->get_net_ptr()->getEscapeVCs(), m_vc_per_vnet);
+    m_escape_vc_mask = mask(escape_vcs);
+    m_adaptive_vc_mask = mask(m_vc_per_vnet) & ~m_escape_vc_mask;
+    m_num_adaptive_vcs = popCount(m_adaptive_vc_mask);
+
+    GarnetNetwork *net_ptr = m_router->get_net_ptr();
+    m_congestion_sensing = net_ptr->getCongestionSensing();
+    m_ewma_decay = 1.0f - 1.0f / net_ptr->getCongestionEwmaWindow();
+    m_occupancy_ewma.assign(m_router->get_num_vnets(), 0.0f);
+    m_ewma_cycle.assign(m_router->get_num_vnets(), Cycles(0));
+}
+
+// Fold the cycles since the last update into the EWMA. The occupancy
+// has been constant over them, since it is updated before every change,
+// so n per-cycle steps collapse into a single decay by decay^n.
+void
+OutputUnit::updateOccupancyEwma(int vnet)
+{
+    Cycles now = m_router->curCycle();
+    if (now <= m_ewma_cycle[vnet])
+        return;
+
+    float occupancy = adaptiveOccupancy(vnet);
+    float decay = std::pow(m_ewma_decay, (float)(now - m_ewma_cycle[vnet]));
+    m_occupancy_ewma[vnet] =
+        occupancy + (m_occupancy_ewma[vnet] - occupancy) * decay;
+    m_ewma_cycle[vnet] = now;
+}
+
+float
+OutputUnit::get_congestion(int vnet)
+{
+    if (m_congestion_sensing == INSTANTANEOUS_)
+        return adaptiveOccupancy(vnet);
+
+    updateOccupancyEwma(vnet);
+    return m_occupancy_ewma[vnet];
 }
 
 void
@@ -69,6 +118,8 @@ OutputUnit::decrement_credit(int out_vc)
             out_vc, m_router->curCycle(), m_credit_link->name());
 
     outVcState[out_vc].decrement_credit();
+    if (!outVcState[out_vc].has_credit())
+        m_credit_vcs[out_vc / m_vc_per_vnet] &= ~vcBit(out_vc);
 }
 
 void
@@ -81,6 +132,7 @@ OutputUnit::increment_credit(int out_vc)
             out_vc, m_router->curCycle(), m_credit_link->name());
 
     outVcState[out_vc].increment_credit();
+    m_credit_vcs[out_vc / m_vc_per_vnet] |= vcBit(out_vc);
 }
 
 // Check if the output VC (i.e., input VC at next router)
@@ -90,7 +142,7 @@ bool
 OutputUnit::has_credit(int out_vc)
 {
     assert(outVcState[out_vc].isInState(ACTIVE_, curTick()));
-    return outVcState[out_vc].has_credit();
+    return m_credit_vcs[out_vc / m_vc_per_vnet] & vcBit(out_vc);
 }
 
 
@@ -98,77 +150,43 @@ OutputUnit::has_credit(int out_vc)
 bool
 OutputUnit::has_free_vc(int vnet)
 {
-    int vc_base = vnet*m_vc_per_vnet;
-    for (int vc = vc_base; vc < vc_base + m_vc_per_vnet; vc++) {
-        if (is_vc_idle(vc, curTick()))
-            return true;
-    }
-
-    return false;
+    return m_free_vcs[vnet] != 0;
 }
 
+// Only the escape or the adaptive VCs of the vnet are eligible,
+// depending on the VC class the flit is using.
 bool
 OutputUnit::has_free_vc_3dTorus_adaptive(int vnet, flit* t_flit)
 {
     bool use_escape_vc = t_flit->get_use_escape_vc();
-    int vc_base = vnet*m_vc_per_vnet;
-    GarnetNetwork* garnet_net = safe_cast<GarnetNetwork*>(m_router->get_net_ptr());
-    uint32_t escape_vcs = garnet_net->getEscapeVCs();
-    if (use_escape_vc) {
-        for (int vc = vc_base; vc < vc_base + escape_vcs; vc++) {
-            if (is_vc_idle(vc, curTick()))
-                return true;
-        }
-    }
-    else {
-        for (int vc = vc_base + escape_vcs; vc < vc_base + m_vc_per_vnet; vc++) {
-            if (is_vc_idle(vc, curTick()))
-                return true;
-        }
-    }
-    return false;
+    return (m_free_vcs[vnet] & vcClassMask(use_escape_vc)) != 0;
 }
+
 // Assign a free output VC to the winner of Switch Allocation
 int
 OutputUnit::select_free_vc(int vnet)
 {
-    int vc_base = vnet*m_vc_per_vnet;
-    for (int vc = vc_base; vc < vc_base + m_vc_per_vnet; vc++) {
-        if (is_vc_idle(vc, curTick())) {
-            outVcState[vc].setState(ACTIVE_, curTick());
-            return vc;
-        }
-    }
+    if (m_free_vcs[vnet] == 0)
+        return -1;
 
-    return -1;
+    int vc = vnet*m_vc_per_vnet + ctz64(m_free_vcs[vnet]);
+    set_vc_state(ACTIVE_, vc, curTick());
+    return vc;
 }
 
 int
 OutputUnit::select_free_vc_3dTorus_adaptive(int vnet, flit* t_flit)
 {
     bool use_escape_vc = t_flit->get_use_escape_vc();
-    int vc_base = vnet*m_vc_per_vnet;
-    GarnetNetwork* garnet_net = safe_cast<GarnetNetwork*>(m_router->get_net_ptr());
-    uint32_t escape_vcs = garnet_net->getEscapeVCs();
-    if (use_escape_vc) {
-        for (int vc = vc_base; vc < vc_base + escape_vcs; vc++) {
-            if (is_vc_idle(vc, curTick())) {
-                outVcState[vc].setState(ACTIVE_, curTick());
-                return vc;
-            }
-        }
-    }
-    else {
-        for (int vc = vc_base + escape_vcs; vc < vc_base + m_vc_per_vnet; vc++) {
-            if (is_vc_idle(vc, curTick())) {
-                outVcState[vc].setState(ACTIVE_, curTick());
-                return vc;
-            }
-        }
-    }
+    uint64_t free_vcs = m_free_vcs[vnet] & vcClassMask(use_escape_vc);
+    if (free_vcs == 0)
+        return -1;
 
-    return -1;
+    int vc = vnet*m_vc_per_vnet + ctz64(free_vcs);
+    set_vc_state(ACTIVE_, vc, curTick());
+    return vc;
 }
+
 /*
  * The wakeup function of the OutputUnit reads the credit signal from the
  * downstream router for the output VC (i.e., input VC at downstream router).
@@ -187,7 +205,7 @@ OutputUnit::wakeup()
         if (t_credit->is_free_signal())
             set_vc_state(IDLE_, t_credit->get_vc(), curTick());
 
-        delete t_credit;
+        m_router->getFlitPool().release(t_credit);
 
         if (m_credit_link->isReady(curTick())) {
             scheduleEvent(Cycles(1));
@@ -35,6 +35,7 @@
 #include <iostream>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/compiler.hh"
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
@@ -57,11 +58,12 @@ class Router;
 class OutputUnit : public Consumer
 {
   public:
-    OutputUnit(int id, PortDirection direction, Router *router,
+    OutputUnit(int id, PortDirectionId direction, Router *router,
                uint32_t consumerVcs);
     ~OutputUnit() = default;
     void set_out_link(NetworkLink *link);
     void set_credit_link(CreditLink *credit_link);
+    CreditLink *get_credit_link() { return m_credit_link; }
     void wakeup();
     flitBuffer* getOutQueue();
     void print(std::ostream& out) const {};
@@ -73,7 +75,21 @@ class OutputUnit : public Consumer
     int select_free_vc(int vnet);
     int select_free_vc_3dTorus_adaptive(int vnet, flit* t_flit);
 
-    inline PortDirection get_direction() { return m_direction; }
+    // Number of idle escape (use_escape_vc) or adaptive VCs in vnet
+    inline int
+    count_free_vcs(int vnet, bool use_escape_vc)
+    {
+        return popCount(m_free_vcs[vnet] & vcClassMask(use_escape_vc));
+    }
+
+    int get_num_adaptive_vcs() { return m_num_adaptive_vcs; }
+
+    // Fraction of the adaptive VCs of vnet that are in use, in [0, 1]:
+    // either right now or averaged over the congestion EWMA window,
+    // depending on the network's congestion sensing mode
+    float get_congestion(int vnet);
+
+    inline PortDirectionId get_direction() { return m_direction; }
 
     int
     get_credit_count(int vc)
@@ -90,7 +106,13 @@ class OutputUnit : public Consumer
     inline void
     set_vc_state(VC_state_type state, int vc, Tick curTime)
     {
-      outVcState[vc].setState(state, curTime);
+        outVcState[vc].setState(state, curTime);
+        if (m_congestion_sensing == EWMA_)
+            updateOccupancyEwma(vc / m_vc_per_vnet);
+        if (state == IDLE_)
+            m_free_vcs[vc / m_vc_per_vnet] |= vcBit(vc);
+        else
+            m_free_vcs[vc / m_vc_per_vnet] &= ~vcBit(vc);
     }
 
     inline bool
@@ -111,9 +133,29 @@ class OutputUnit : public Consumer
     uint32_t functionalWrite(Packet *pkt);
 
   private:
+    // Bit of vc within the masks of its vnet
+    inline uint64_t vcBit(int vc) { return 1ULL << (vc % m_vc_per_vnet); }
+
+    inline uint64_t
+    vcClassMask(bool use_escape_vc)
+    {
+        return use_escape_vc ? m_escape_vc_mask : m_adaptive_vc_mask;
+    }
+
+    inline float
+    adaptiveOccupancy(int vnet)
+    {
+        if (m_num_adaptive_vcs == 0)
+            return 0.0f;
+        return (float)(m_num_adaptive_vcs - count_free_vcs(vnet, false)) /
+               m_num_adaptive_vcs;
+    }
+
+    void updateOccupancyEwma(int vnet);
+
     Router *m_router;
     GEM5_CLASS_VAR_USED int m_id;
-    PortDirection m_direction;
+    PortDirectionId m_direction;
     int m_vc_per_vnet;
     NetworkLink *m_out_link;
     CreditLink *m_credit_link;
@@ -122,6 +164,23 @@ class OutputUnit : public Consumer
     flitBuffer outBuffer;
     // vc state of downstream router
     std::vector<OutVcState> outVcState;
+
+    // Per vnet, one bit per VC: VCs that are idle, and VCs that have
+    // at least one credit. Kept in sync with outVcState so that VC
+    // availability checks and selection do not scan the VCs.
+    std::vector<uint64_t> m_free_vcs;
+    std::vector<uint64_t> m_credit_vcs;
+    // VCs of a vnet reserved as escape VCs, and the remaining ones
+    uint64_t m_escape_vc_mask;
+    uint64_t m_adaptive_vc_mask;
+    int m_num_adaptive_vcs;
+
+    // Per vnet EWMA of the adaptive VC occupancy, and the cycle up to
+    // which it accounts for the occupancy
+    CongestionSensing m_congestion_sensing;
+    float m_ewma_decay;
+    std::vector<float> m_occupancy_ewma;
+    std::vector<Cycles> m_ewma_cycle;
 };
 
 } // namespace garnet
@@ -32,6 +32,7 @@
 
 #include "mem/ruby/network/garnet/Router.hh"
 
+#include "base/bitfield.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
@@ -52,9 +53,12 @@ Router::Router(const Params &p)
   : BasicRouter(p), Consumer(this), m_latency(p.latency),
     m_virtual_networks(p.virt_nets), m_vc_per_vnet(p.vcs_per_vnet),
     m_num_vcs(m_virtual_networks * m_vc_per_vnet), m_bit_width(p.width),
-    m_network_ptr(nullptr), routingUnit(this), switchAllocator(this),
-    crossbarSwitch(this)
+    m_network_ptr(nullptr), m_flit_pool(nullptr), routingUnit(this),
+    switchAllocator(this), crossbarSwitch(this), m_pending_inports(0),
+    m_pending_outports(0), m_occupied_inports(0)
 {
+    fatal_if(m_num_vcs > 64, "Router%d: at most 64 VCs per port are "
+             "supported, got %d.", m_id, m_num_vcs);
     m_input_unit.clear();
     m_output_unit.clear();
 }
@@ -66,6 +70,7 @@ Router::init()
 
     switchAllocator.init();
     crossbarSwitch.init();
+    routingUnit.init();
 }
 
 void
@@ -74,9 +79,20 @@ Router::wakeup()
     DPRINTF(RubyNetwork, "Router %d woke up\n", m_id);
     assert(clockEdge() == curTick());
 
+    bool did_work = false;
+
     // check for incoming flits
-    for (int inport = 0; inport < m_input_unit.size(); inport++) {
-        m_input_unit[inport]->wakeup();
+    // Only the ports whose input link has been sent a flit are visited;
+    // a port stays pending until its link has been drained.
+    for (uint64_t ports = m_pending_inports; ports; ports &= ports - 1) {
+        int inport = ctz64(ports);
+        NetworkLink *in_link = m_input_unit[inport]->get_in_link();
+        if (in_link->isReady(curTick())) {
+            m_input_unit[inport]->wakeup();
+            did_work = true;
+        }
+        if (in_link->getBuffer()->isEmpty())
+            m_pending_inports &= ~(1ULL << inport);
     }
 
     // check for incoming credits
@@ -85,19 +101,35 @@ Router::wakeup()
     //     credit traversal (1-cycle) + SA (1-cycle) + Link Traversal (1-cycle)
     // if we want the credit update to take place after SA, this loop should
     // be moved after the SA request
-    for (int outport = 0; outport < m_output_unit.size(); outport++) {
-        m_output_unit[outport]->wakeup();
+    for (uint64_t ports = m_pending_outports; ports; ports &= ports - 1) {
+        int outport = ctz64(ports);
+        CreditLink *credit_link = m_output_unit[outport]->get_credit_link();
+        if (credit_link->isReady(curTick())) {
+            m_output_unit[outport]->wakeup();
+            did_work = true;
+        }
+        if (credit_link->getBuffer()->isEmpty())
+            m_pending_outports &= ~(1ULL << outport);
     }
 
     // Switch Allocation
+    double sa_requests = switchAllocator.get_input_arbiter_activity();
     switchAllocator.wakeup();
+    if (switchAllocator.get_input_arbiter_activity() != sa_requests)
+        did_work = true;
 
     // Switch Traversal
+    double xbar_traversals = crossbarSwitch.get_crossbar_activity();
     crossbarSwitch.wakeup();
+    if (crossbarSwitch.get_crossbar_activity() != xbar_traversals)
+        did_work = true;
+
+    if (!did_work)
+        m_wasted_wakeups++;
 }
 
 void
-Router::addInPort(PortDirection inport_dirn,
+Router::addInPort(PortDirectionId inport_dirn,
                   NetworkLink *in_link, CreditLink *credit_link)
 {
     fatal_if(in_link->bitWidth != m_bit_width, "Widths of link %s(%d)does"
@@ -105,11 +137,14 @@ Router::addInPort(PortDirection inport_dirn,
             "Units.", in_link->name(), in_link->bitWidth, m_id, m_bit_width);
 
     int port_num = m_input_unit.size();
+    fatal_if(port_num >= 64, "Router%d: at most 64 input ports are "
+             "supported.", m_id);
     InputUnit *input_unit = new InputUnit(port_num, inport_dirn, this);
 
     input_unit->set_in_link(in_link);
     input_unit->set_credit_link(credit_link);
     in_link->setLinkConsumer(this);
+    in_link->setConsumerPort(&m_pending_inports, port_num);
     in_link->setVcsPerVnet(get_vc_per_vnet());
     credit_link->setSourceQueue(input_unit->getCreditQueue(), this);
     credit_link->setVcsPerVnet(get_vc_per_vnet());
@@ -120,7 +155,7 @@ Router::addInPort(PortDirection inport_dirn,
 }
 
 void
-Router::addOutPort(PortDirection outport_dirn,
+Router::addOutPort(PortDirectionId outport_dirn,
                    NetworkLink *out_link,
                    std::vector<NetDest>& routing_table_entry, int link_weight,
                    CreditLink *credit_link, uint32_t consumerVcs)
@@ -129,12 +164,15 @@ Router::addOutPort(PortDirection outport_dirn,
             " Consider inserting SerDes Units");
 
     int port_num = m_output_unit.size();
+    fatal_if(port_num >= 64, "Router%d: at most 64 output ports are "
+             "supported.", m_id);
     OutputUnit *output_unit = new OutputUnit(port_num, outport_dirn, this,
                                              consumerVcs);
 
     output_unit->set_out_link(out_link);
     output_unit->set_credit_link(credit_link);
     credit_link->setLinkConsumer(this);
+    credit_link->setConsumerPort(&m_pending_outports, port_num);
     credit_link->setVcsPerVnet(consumerVcs);
     out_link->setSourceQueue(output_unit->getOutQueue(), this);
     out_link->setVcsPerVnet(consumerVcs);
@@ -146,24 +184,49 @@ Router::addOutPort(PortDirection outport_dirn,
     routingUnit.addOutDirection(outport_dirn, port_num);
 }
 
-PortDirection
+PortDirectionId
 Router::getOutportDirection(int outport)
 {
     return m_output_unit[outport]->get_direction();
 }
 
-PortDirection
+PortDirectionId
 Router::getInportDirection(int inport)
 {
     return m_input_unit[inport]->get_direction();
 }
 
 int
-Router::route_compute(RouteInfo route, int inport, PortDirection inport_dirn, flit* t_flit)
+Router::route_compute(RouteInfo route, int inport, PortDirectionId inport_dirn,
+                      flit* t_flit)
 {
     return routingUnit.outportCompute(route, inport, inport_dirn, t_flit);
 }
 
+void
+Router::setDownstreamRouter(int outport, Router *router, int inport,
+                            PortDirectionId inport_dirn)
+{
+    if (m_downstream.size() <= outport)
+        m_downstream.resize(outport + 1);
+    m_downstream[outport].router = router;
+    m_downstream[outport].inport = inport;
+    m_downstream[outport].inport_dirn = inport_dirn;
+}
+
+int
+Router::lookahead_route(int outport, flit *t_flit)
+{
+    if (outport >= m_downstream.size() || !m_downstream[outport].router)
+        return -1;
+
+    // The next router decides with its own view of the network, as it
+    // would when the flit arrives
+    const Downstream &next = m_downstream[outport];
+    return next.router->route_compute(t_flit->get_route(), next.inport,
+                                      next.inport_dirn, t_flit);
+}
+
 void
 Router::grant_switch(int inport, flit *t_flit)
 {
@@ -178,13 +241,11 @@ Router::schedule_wakeup(Cycles time)
 }
 
 std::string
-Router::getPortDirectionName(PortDirection direction)
+Router::getPortDirectionName(PortDirectionId direction)
 {
-    // PortDirection is actually a string
-    // If not, then this function should add a switch
-    // statement to convert direction to a string
-    // that can be printed out
-    return direction;
+    // Directions are kept as ids inside the router; the name is
+    // only needed for debug and stats output
+    return portDirectionName(direction);
 }
 
 void
@@ -216,6 +277,11 @@ Router::regStats()
         .name(name() + ".sw_output_arbiter_activity")
         .flags(statistics::nozero)
     ;
+
+    m_wasted_wakeups
+        .name(name() + ".wasted_wakeups")
+        .flags(statistics::nozero)
+    ;
 }
 
 void
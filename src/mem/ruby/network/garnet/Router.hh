@@ -75,9 +75,9 @@ class Router : public BasicRouter, public Consumer
     void print(std::ostream& out) const {};
 
     void init();
-    void addInPort(PortDirection inport_dirn, NetworkLink *link,
+    void addInPort(PortDirectionId inport_dirn, NetworkLink *link,
                    CreditLink *credit_link);
-    void addOutPort(PortDirection outport_dirn, NetworkLink *link,
+    void addOutPort(PortDirectionId outport_dirn, NetworkLink *link,
                     std::vector<NetDest>& routing_table_entry,
                     int link_weight, CreditLink *credit_link,
                     uint32_t consumerVcs);
@@ -93,9 +93,12 @@ class Router : public BasicRouter, public Consumer
     void init_net_ptr(GarnetNetwork* net_ptr)
     {
         m_network_ptr = net_ptr;
+        m_flit_pool = &net_ptr->getFlitPool(eventQueue());
     }
 
     GarnetNetwork* get_net_ptr()                    { return m_network_ptr; }
+    // Allocator for the credits sent by this router
+    FlitPool &getFlitPool()                         { return *m_flit_pool; }
 
     InputUnit*
     getInputUnit(unsigned port)
@@ -113,14 +116,49 @@ class Router : public BasicRouter, public Consumer
 
     int getBitWidth() { return m_bit_width; }
 
-    PortDirection getOutportDirection(int outport);
-    PortDirection getInportDirection(int inport);
+    // Switch allocator grants since the last stats reset
+    double
+    get_sa_grants()
+    {
+        return switchAllocator.get_output_arbiter_activity();
+    }
+
+    PortDirectionId getOutportDirection(int outport);
+    PortDirectionId getInportDirection(int inport);
+
+    int route_compute(RouteInfo route, int inport, PortDirectionId direction,
+                      flit* t_flit);
+
+    // Lookahead routing: the router fed by each outport computes the
+    // route of the head flits granted to that outport
+    bool
+    lookahead_routing() const
+    {
+        return m_network_ptr->isLookaheadRouting();
+    }
+    void setDownstreamRouter(int outport, Router *router, int inport,
+                             PortDirectionId inport_dirn);
+    int lookahead_route(int outport, flit *t_flit);
 
-    int route_compute(RouteInfo route, int inport, PortDirection direction, flit* t_flit);
     void grant_switch(int inport, flit *t_flit);
     void schedule_wakeup(Cycles time);
 
-    std::string getPortDirectionName(PortDirection direction);
+    // Input ports with at least one flit buffered in an input VC.
+    // Maintained by the InputUnits; used to skip idle ports in SA.
+    uint64_t getOccupiedInports() const { return m_occupied_inports; }
+    void
+    setInportOccupied(int inport)
+    {
+        m_occupied_inports |= 1ULL << inport;
+    }
+
+    void
+    clearInportOccupied(int inport)
+    {
+        m_occupied_inports &= ~(1ULL << inport);
+    }
+
+    std::string getPortDirectionName(PortDirectionId direction);
     void printFaultVector(std::ostream& out);
     void printAggregateFaultProbability(std::ostream& out);
 
@@ -147,6 +185,7 @@ class Router : public BasicRouter, public Consumer
     uint32_t m_virtual_networks, m_vc_per_vnet, m_num_vcs;
     uint32_t m_bit_width;
     GarnetNetwork *m_network_ptr;
+    FlitPool *m_flit_pool;
 
     RoutingUnit routingUnit;
     SwitchAllocator switchAllocator;
@@ -155,6 +194,22 @@ class Router : public BasicRouter, public Consumer
     std::vector<std::shared_ptr<InputUnit>> m_input_unit;
     std::vector<std::shared_ptr<OutputUnit>> m_output_unit;
 
+    // Router and input port at the other end of each outport, or no
+    // router for the outports to NIs
+    struct Downstream
+    {
+        Router *router = nullptr;
+        int inport = -1;
+        PortDirectionId inport_dirn = OTHER_DIRN_;
+    };
+    std::vector<Downstream> m_downstream;
+
+    // One bit per port: input links holding flits, credit links holding
+    // credits (both set by the links), and input units holding flits
+    uint64_t m_pending_inports;
+    uint64_t m_pending_outports;
+    uint64_t m_occupied_inports;
+
     // Statistical variables required for power computations
     statistics::Scalar m_buffer_reads;
     statistics::Scalar m_buffer_writes;
@@ -163,6 +218,9 @@ class Router : public BasicRouter, public Consumer
     statistics::Scalar m_sw_output_arbiter_activity;
 
     statistics::Scalar m_crossbar_activity;
+
+    // Wakeups that found no flit, credit or SA request to act on
+    statistics::Scalar m_wasted_wakeups;
 };
 
 } // namespace garnet
@@ -30,10 +30,11 @@
 
 #include "mem/ruby/network/garnet/RoutingUnit.hh"
 
-#include <cmath>
 #include <cfloat>
+#include <cmath>
+#include <map>
 
-#include "base/cast.hh"
+#include "base/bitfield.hh"
 #include "base/compiler.hh"
 #include "base/random.hh"
 #include "debug/RubyNetwork.hh"
@@ -52,16 +53,123 @@ namespace garnet
 {
 
 RoutingUnit::RoutingUnit(Router *router)
+    : m_net_ptr(nullptr), m_num_route_nodes(0), m_random(&random_mt)
 {
     m_router = router;
     m_routing_table.clear();
     m_weight_table.clear();
+    m_inports_dirn2idx.fill(-1);
+    m_outports_dirn2idx.fill(-1);
 
     // Debug: Print when RoutingUnit is created
     printf("[RoutingUnit Debug] RoutingUnit created for Router %d\n",
            m_router->get_id());
 }
 
+// Shortest distance between two positions on a ring, and whether it is
+// reached going forward (ties go forward)
+static std::pair<int, bool>
+torusDistance(int curr, int dest, int dim_size)
+{
+    int forward_dist = (dest - curr + dim_size) % dim_size;
+    int backward_dist = (curr - dest + dim_size) % dim_size;
+
+    if (forward_dist <= backward_dist) {
+        return {forward_dist, true};  // true = forward direction
+    } else {
+        return {backward_dist, false}; // false = backward direction
+    }
+}
+
+// Dimension (0 = X, 1 = Y, 2 = Z) a torus direction moves along
+static inline int
+dirnDimension(PortDirectionId dirn)
+{
+    assert(dirn >= EAST_ && dirn <= DOWN_);
+    return (dirn - EAST_) / 2;
+}
+
+void
+RoutingUnit::init()
+{
+    m_net_ptr = m_router->get_net_ptr();
+
+    // Seeded from random_mt while still single-threaded, in router
+    // order, so that runs are deterministic for a given seed
+    if (m_net_ptr->isPartitioned()) {
+        m_own_random.reset(new Random(random_mt.random<uint32_t>()));
+        m_random = m_own_random.get();
+    }
+
+    buildRouteCandidates();
+
+    RoutingAlgorithm routing_algorithm =
+        (RoutingAlgorithm) m_net_ptr->getRoutingAlgorithm();
+    if (routing_algorithm != TORUS3D_ &&
+        routing_algorithm != TORUS3D_ADAPTIVE_) {
+        return;
+    }
+
+    m_torus_dims[0] = m_net_ptr->getTorusX();
+    m_torus_dims[1] = m_net_ptr->getTorusY();
+    m_torus_dims[2] = m_net_ptr->getTorusZ();
+    int num_routers = m_net_ptr->getNumRouters();
+
+    fatal_if(m_torus_dims[0] * m_torus_dims[1] * m_torus_dims[2] !=
+             num_routers, "3D Torus routing: %dx%dx%d torus does not match "
+             "%d routers", m_torus_dims[0], m_torus_dims[1],
+             m_torus_dims[2], num_routers);
+
+    // Convert router IDs to 3D coordinates
+    auto to_coord = [this](int id, int coord[3]) {
+        coord[2] = id / (m_torus_dims[0] * m_torus_dims[1]);
+        int remainder = id % (m_torus_dims[0] * m_torus_dims[1]);
+        coord[1] = remainder / m_torus_dims[0];
+        coord[0] = remainder % m_torus_dims[0];
+    };
+    to_coord(m_router->get_id(), m_torus_coord);
+
+    // Positive and negative direction of each dimension
+    const PortDirectionId dim_dirns[3][2] = {
+        {EAST_, WEST_}, {NORTH_, SOUTH_}, {UP_, DOWN_}
+    };
+
+    m_torus_routes.resize(num_routers);
+    for (int dest = 0; dest < num_routers; dest++) {
+        int dest_coord[3];
+        to_coord(dest, dest_coord);
+
+        TorusRoute &entry = m_torus_routes[dest];
+        entry.minimal_dirns = 0;
+        entry.total_hops = 0;
+        for (int dim = 0; dim < 3; dim++) {
+            auto [dist, forward] = torusDistance(m_torus_coord[dim],
+                                                 dest_coord[dim],
+                                                 m_torus_dims[dim]);
+            entry.hops[dim] = dist;
+            entry.total_hops += dist;
+            if (dist > 0)
+                entry.minimal_dirns |= dirnBit(dim_dirns[dim][!forward]);
+        }
+
+        if (dest == m_router->get_id()) {
+            entry.escape_dirn = LOCAL_;
+        } else {
+            entry.escape_dirn = computeEscapeVCDirection(
+                m_torus_coord[0], m_torus_coord[1], m_torus_coord[2],
+                dest_coord[0], dest_coord[1], dest_coord[2],
+                m_torus_dims[0], m_torus_dims[1], m_torus_dims[2]);
+        }
+    }
+}
+
+const RoutingUnit::TorusRoute &
+RoutingUnit::getTorusRoute(int dest_router) const
+{
+    assert(dest_router >= 0 && dest_router < m_torus_routes.size());
+    return m_torus_routes[dest_router];
+}
+
 void
 RoutingUnit::addRoute(std::vector<NetDest>& routing_table_entry)
 {
@@ -96,78 +204,140 @@ RoutingUnit::supportsVnet(int vnet, std::vector<int> sVnets)
     return false;
 }
 
-/*
- * This is the default routing algorithm in garnet.
- * The routing table is populated during topology creation.
- * Routes can be biased via weight assignments in the topology file.
- * Correct weight assignments are critical to provide deadlock avoidance.
- */
-int
-RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
+void
+RoutingUnit::buildRouteCandidates()
 {
-    // First find all possible output link candidates
-    // For ordered vnet, just choose the first
+    // For ordered vnet, only the first minimum-weight link is kept
     // (to make sure different packets don't choose different routes)
-    // For unordered vnet, randomly choose any of the links
+    // For unordered vnet, all of them are kept to choose randomly from
     // To have a strict ordering between links, they should be given
     // different weights in the topology file
-
-    int output_link = -1;
-    int min_weight = INFINITE_;
-    std::vector<int> output_link_candidates;
-    int num_candidates = 0;
-
-    // Identify the minimum weight among the candidate output links
-    for (int link = 0; link < m_routing_table[vnet].size(); link++) {
-        if (msg_destination.intersectionIsNotEmpty(
-            m_routing_table[vnet][link])) {
-
-        if (m_weight_table[link] <= min_weight)
-            min_weight = m_weight_table[link];
+    m_num_route_nodes = MachineType_base_number(MachineType_NUM);
+    int num_vnets = m_routing_table.size();
+    fatal_if(m_weight_table.size() > 256, "Router%d: table-based routing "
+             "supports at most 256 outports, got %d.", m_router->get_id(),
+             m_weight_table.size());
+
+    m_vnet_routes.assign(num_vnets, -1);
+    m_route_sets.clear();
+    m_candidate_sets.assign(1, 0);
+    m_candidate_outports.clear();
+
+    std::map<std::vector<uint8_t>, uint16_t> set_ids;
+    std::vector<int> min_weight(m_num_route_nodes);
+    std::vector<std::vector<uint8_t>> candidates(m_num_route_nodes);
+    std::vector<uint16_t> node_sets(m_num_route_nodes);
+    for (int vnet = 0; vnet < num_vnets; vnet++) {
+        std::fill(min_weight.begin(), min_weight.end(), INFINITE_);
+        for (auto &node_candidates : candidates)
+            node_candidates.clear();
+
+        // Links are visited in outport order, which keeps the candidates
+        // sorted, as the routing table search used to find them
+        for (int link = 0; link < m_routing_table[vnet].size(); link++) {
+            int weight = m_weight_table[link];
+            for (NodeID node : m_routing_table[vnet][link].getAllDest()) {
+                if (weight < min_weight[node]) {
+                    min_weight[node] = weight;
+                    candidates[node].clear();
+                }
+                if (weight == min_weight[node])
+                    candidates[node].push_back(link);
+            }
         }
-    }
 
-    // Collect all candidate output links with this minimum weight
-    for (int link = 0; link < m_routing_table[vnet].size(); link++) {
-        if (msg_destination.intersectionIsNotEmpty(
-            m_routing_table[vnet][link])) {
+        bool ordered = m_net_ptr->isVNetOrdered(vnet);
+        for (int node = 0; node < m_num_route_nodes; node++) {
+            if (ordered && candidates[node].size() > 1)
+                candidates[node].resize(1);
+            auto [it, added] = set_ids.emplace(candidates[node],
+                                               set_ids.size());
+            if (added) {
+                fatal_if(set_ids.size() > 65536, "Router%d: too many "
+                         "distinct route candidate sets.",
+                         m_router->get_id());
+                m_candidate_outports.insert(m_candidate_outports.end(),
+                                            candidates[node].begin(),
+                                            candidates[node].end());
+                m_candidate_sets.push_back(m_candidate_outports.size());
+            }
+            node_sets[node] = it->second;
+        }
 
-            if (m_weight_table[link] == min_weight) {
-                num_candidates++;
-                output_link_candidates.push_back(link);
+        for (int other = 0; other < m_route_sets.size(); other++) {
+            if (m_route_sets[other] == node_sets) {
+                m_vnet_routes[vnet] = other;
+                break;
             }
         }
+        if (m_vnet_routes[vnet] < 0) {
+            m_vnet_routes[vnet] = m_route_sets.size();
+            m_route_sets.push_back(node_sets);
+        }
     }
 
-    if (output_link_candidates.size() == 0) {
+    // Only the candidates are used from now on
+    std::vector<std::vector<NetDest>>().swap(m_routing_table);
+}
+
+/*
+ * This is the default routing algorithm in garnet.
+ * The routing table is populated during topology creation.
+ * Routes can be biased via weight assignments in the topology file.
+ * Correct weight assignments are critical to provide deadlock avoidance.
+ * The minimum-weight links towards each destination are precomputed
+ * from it in init().
+ */
+int
+RoutingUnit::lookupRoutingTable(int vnet, NodeID dest_node)
+{
+    assert(vnet < m_vnet_routes.size() && dest_node < m_num_route_nodes);
+    int set = m_route_sets[m_vnet_routes[vnet]][dest_node];
+    uint32_t first = m_candidate_sets[set];
+    uint32_t num_candidates = m_candidate_sets[set + 1] - first;
+
+    if (num_candidates == 0) {
         fatal("Fatal Error:: No Route exists from this Router.");
         exit(0);
     }
 
     // Randomly select any candidate output link
-    int candidate = 0;
-    if (!(m_router->get_net_ptr())->isVNetOrdered(vnet))
-        candidate = rand() % num_candidates;
+    uint32_t candidate = 0;
+    if (num_candidates > 1)
+        candidate = m_random->random<uint32_t>(0, num_candidates - 1);
 
-    output_link = output_link_candidates.at(candidate);
-    return output_link;
+    return m_candidate_outports[first + candidate];
 }
 
-
 void
-RoutingUnit::addInDirection(PortDirection inport_dirn, int inport_idx)
+RoutingUnit::addInDirection(PortDirectionId inport_dirn, int inport_idx)
 {
+    if (inport_idx >= m_inports_idx2dirn.size())
+        m_inports_idx2dirn.resize(inport_idx + 1, OTHER_DIRN_);
     m_inports_dirn2idx[inport_dirn] = inport_idx;
     m_inports_idx2dirn[inport_idx]  = inport_dirn;
 }
 
 void
-RoutingUnit::addOutDirection(PortDirection outport_dirn, int outport_idx)
+RoutingUnit::addOutDirection(PortDirectionId outport_dirn, int outport_idx)
 {
+    if (outport_idx >= m_outports_idx2dirn.size())
+        m_outports_idx2dirn.resize(outport_idx + 1, OTHER_DIRN_);
     m_outports_dirn2idx[outport_dirn] = outport_idx;
     m_outports_idx2dirn[outport_idx]  = outport_dirn;
 }
 
+int
+RoutingUnit::getOutportForDirection(PortDirectionId dirn)
+{
+    int outport = m_outports_dirn2idx[dirn];
+    if (outport == -1) {
+        panic("Outport direction %s not found in router %d",
+              portDirectionName(dirn), m_router->get_id());
+    }
+    return outport;
+}
+
 // outportCompute() is called by the InputUnit
 // It calls the routing table by default.
 // A template for adaptive topology-specific routing algorithm
@@ -176,7 +346,7 @@ RoutingUnit::addOutDirection(PortDirection outport_dirn, int outport_idx)
 
 int
 RoutingUnit::outportCompute(RouteInfo route, int inport,
-                            PortDirection inport_dirn, flit* t_flit)
+                            PortDirectionId inport_dirn, flit* t_flit)
 {
     int outport = -1;
 
@@ -185,18 +355,18 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
         // Multiple NIs may be connected to this router,
         // all with output port direction = "Local"
         // Get exact outport id from table
-        outport = lookupRoutingTable(route.vnet, route.net_dest);
+        outport = lookupRoutingTable(route.vnet, route.dest_ni);
         return outport;
     }
 
     // Routing Algorithm set in GarnetNetwork.py
     // Can be over-ridden from command line using --routing-algorithm = 1
     RoutingAlgorithm routing_algorithm =
-        (RoutingAlgorithm) m_router->get_net_ptr()->getRoutingAlgorithm();
+        (RoutingAlgorithm) m_net_ptr->getRoutingAlgorithm();
 
     switch (routing_algorithm) {
         case TABLE_:  outport =
-            lookupRoutingTable(route.vnet, route.net_dest); break;
+            lookupRoutingTable(route.vnet, route.dest_ni); break;
         case XY_:     outport =
             outportComputeXY(route, inport, inport_dirn); break;
         // any custom algorithm
@@ -207,7 +377,7 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
         case TORUS3D_ADAPTIVE_: outport =
             outportComputeTorus3DAdaptive(route, inport, inport_dirn, t_flit); break;
         default: outport =
-            lookupRoutingTable(route.vnet, route.net_dest); break;
+            lookupRoutingTable(route.vnet, route.dest_ni); break;
     }
 
     assert(outport != -1);
@@ -220,12 +390,12 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
 int
 RoutingUnit::outportComputeXY(RouteInfo route,
                               int inport,
-                              PortDirection inport_dirn)
+                              PortDirectionId inport_dirn)
 {
-    PortDirection outport_dirn = "Unknown";
+    PortDirectionId outport_dirn = OTHER_DIRN_;
 
-    [[maybe_unused]] int num_rows = m_router->get_net_ptr()->getNumRows();
-    int num_cols = m_router->get_net_ptr()->getNumCols();
+    [[maybe_unused]] int num_rows = m_net_ptr->getNumRows();
+    int num_cols = m_net_ptr->getNumCols();
     assert(num_rows > 0 && num_cols > 0);
 
     int my_id = m_router->get_id();
@@ -247,21 +417,21 @@ RoutingUnit::outportComputeXY(RouteInfo route,
 
     if (x_hops > 0) {
         if (x_dirn) {
-            assert(inport_dirn == "Local" || inport_dirn == "West");
-            outport_dirn = "East";
+            assert(inport_dirn == LOCAL_ || inport_dirn == WEST_);
+            outport_dirn = EAST_;
         } else {
-            assert(inport_dirn == "Local" || inport_dirn == "East");
-            outport_dirn = "West";
+            assert(inport_dirn == LOCAL_ || inport_dirn == EAST_);
+            outport_dirn = WEST_;
         }
     } else if (y_hops > 0) {
         if (y_dirn) {
             // "Local" or "South" or "West" or "East"
-            assert(inport_dirn != "North");
-            outport_dirn = "North";
+            assert(inport_dirn != NORTH_);
+            outport_dirn = NORTH_;
         } else {
             // "Local" or "North" or "West" or "East"
-            assert(inport_dirn != "South");
-            outport_dirn = "South";
+            assert(inport_dirn != SOUTH_);
+            outport_dirn = SOUTH_;
         }
     } else {
         // x_hops == 0 and y_hops == 0
@@ -270,7 +440,7 @@ RoutingUnit::outportComputeXY(RouteInfo route,
         panic("x_hops == y_hops == 0");
     }
 
-    return m_outports_dirn2idx[outport_dirn];
+    return getOutportForDirection(outport_dirn);
 }
 
 // Template for implementing custom routing algorithm
@@ -278,7 +448,7 @@ RoutingUnit::outportComputeXY(RouteInfo route,
 int
 RoutingUnit::outportComputeCustom(RouteInfo route,
                                  int inport,
-                                 PortDirection inport_dirn)
+                                 PortDirectionId inport_dirn)
 {
     panic("%s placeholder executed", __FUNCTION__);
 }
@@ -289,85 +459,21 @@ RoutingUnit::outportComputeCustom(RouteInfo route,
 int
 RoutingUnit::outportComputeTorus3D(RouteInfo route,
                                    int inport,
-                                   PortDirection inport_dirn)
+                                   PortDirectionId inport_dirn)
 {
-    PortDirection outport_dirn = "Unknown";
-
-    // Get torus dimensions from network
-    GarnetNetwork* garnet_net =
-        safe_cast<GarnetNetwork*>(m_router->get_net_ptr());
-
-    // Get dimensions from network parameters
-    int dim_x = garnet_net->getTorusX();
-    int dim_y = garnet_net->getTorusY();
-    int dim_z = garnet_net->getTorusZ();
-
-    // Convert router IDs to 3D coordinates
-    int my_id = m_router->get_id();
-    int dest_id = route.dest_router;
-
-    // Convert to 3D coordinates
-    int my_z = my_id / (dim_x * dim_y);
-    int my_remainder = my_id % (dim_x * dim_y);
-    int my_y = my_remainder / dim_x;
-    int my_x = my_remainder % dim_x;
-
-    int dest_z = dest_id / (dim_x * dim_y);
-    int dest_remainder = dest_id % (dim_x * dim_y);
-    int dest_y = dest_remainder / dim_x;
-    int dest_x = dest_remainder % dim_x;
-
-    // Calculate distance in each dimension considering torus wraparound
-    auto torus_distance =
-        [](int curr, int dest, int dim_size) -> std::pair<int, bool> {
-        int forward_dist = (dest - curr + dim_size) % dim_size;
-        int backward_dist = (curr - dest + dim_size) % dim_size;
-
-        if (forward_dist <= backward_dist) {
-            return {forward_dist, true};  // true = forward direction
-        } else {
-            return {backward_dist, false}; // false = backward direction
-        }
-    };
-
-    auto [x_dist, x_forward] = torus_distance(my_x, dest_x, dim_x);
-    auto [y_dist, y_forward] = torus_distance(my_y, dest_y, dim_y);
-    auto [z_dist, z_forward] = torus_distance(my_z, dest_z, dim_z);
+    const TorusRoute &entry = getTorusRoute(route.dest_router);
 
-    // Dimension-Order Routing: route X first, then Y, then Z
-    if (x_dist > 0) {
-        // Route in X dimension
-        if (x_forward) {
-            outport_dirn = "East";
-        } else {
-            outport_dirn = "West";
-        }
-    } else if (y_dist > 0) {
-        // Route in Y dimension
-        if (y_forward) {
-            outport_dirn = "North";
-        } else {
-            outport_dirn = "South";
-        }
-    } else if (z_dist > 0) {
-        // Route in Z dimension
-        if (z_forward) {
-            outport_dirn = "Up";
-        } else {
-            outport_dirn = "Down";
-        }
-    } else {
+    // Dimension-Order Routing: route X first, then Y, then Z.
+    // Directions are numbered in X, Y, Z order, so this is the lowest
+    // minimal direction.
+    if (entry.minimal_dirns == 0) {
         // Should not reach here as destination check is done in outportCompute
         panic("All dimensions have zero distance in 3D Torus routing");
     }
+    PortDirectionId outport_dirn =
+        (PortDirectionId)ctz32(entry.minimal_dirns);
 
-    // Check if outport direction exists in the map
-    if (m_outports_dirn2idx.find(outport_dirn) == m_outports_dirn2idx.end()) {
-        panic("3D Torus routing: outport direction %s not found in router %d",
-              outport_dirn.c_str(), m_router->get_id());
-    }
-
-    return m_outports_dirn2idx[outport_dirn];
+    return getOutportForDirection(outport_dirn);
 }
 
 // 3D Torus Adaptive Routing with Duato-style Escape VCs
@@ -376,76 +482,16 @@ RoutingUnit::outportComputeTorus3D(RouteInfo route,
 int
 RoutingUnit::outportComputeTorus3DAdaptive(RouteInfo route,
                                           int inport,
-                                          PortDirection inport_dirn,
-                                            flit* t_flit)
+                                          PortDirectionId inport_dirn,
+                                          flit* t_flit)
 {
-    GarnetNetwork* garnet_net =
-        safe_cast<GarnetNetwork*>(m_router->get_net_ptr());
-
-    int dim_x = garnet_net->getTorusX();
-    int dim_y = garnet_net->getTorusY();
-    int dim_z = garnet_net->getTorusZ();
-
-    int my_id = m_router->get_id();
-    int dest_id = route.dest_router;
-
-    // Convert to 3D coordinates
-    int my_z = my_id / (dim_x * dim_y);
-    int my_remainder = my_id % (dim_x * dim_y);
-    int my_y = my_remainder / dim_x;
-    int my_x = my_remainder % dim_x;
-
-    int dest_z = dest_id / (dim_x * dim_y);
-    int dest_remainder = dest_id % (dim_x * dim_y);
-    int dest_y = dest_remainder / dim_x;
-    int dest_x = dest_remainder % dim_x;
-
-    // Calculate distance in each dimension considering torus wraparound
-    auto torus_distance =
-        [](int curr, int dest, int dim_size) -> std::pair<int, bool> {
-        int forward_dist = (dest - curr + dim_size) % dim_size;
-        int backward_dist = (curr - dest + dim_size) % dim_size;
-
-        if (forward_dist <= backward_dist) {
-            return {forward_dist, true};  // true = forward direction
-        } else {
-            return {backward_dist, false}; // false = backward direction
-        }
-    };
+    const TorusRoute &entry = getTorusRoute(route.dest_router);
 
-    auto [x_dist, x_forward] = torus_distance(my_x, dest_x, dim_x);
-    auto [y_dist, y_forward] = torus_distance(my_y, dest_y, dim_y);
-    auto [z_dist, z_forward] = torus_distance(my_z, dest_z, dim_z);
-
-    // Collect all valid minimal paths (directions that make progress)
-    std::vector<PortDirection> adaptive_candidates;
-
-    if (x_dist > 0) {
-        if (x_forward) {
-            adaptive_candidates.push_back("East");
-        } else {
-            adaptive_candidates.push_back("West");
-        }
-    }
-
-    if (y_dist > 0) {
-        if (y_forward) {
-            adaptive_candidates.push_back("North");
-        } else {
-            adaptive_candidates.push_back("South");
-        }
-    }
-
-    if (z_dist > 0) {
-        if (z_forward) {
-            adaptive_candidates.push_back("Up");
-        } else {
-            adaptive_candidates.push_back("Down");
-        }
-    }
+    // All valid minimal paths (directions that make progress)
+    PortDirectionMask adaptive_candidates = entry.minimal_dirns;
 
     // If no progress needed in any dimension, packet should be at destination
-    if (adaptive_candidates.empty()) {
+    if (adaptive_candidates == 0) {
         panic("No adaptive candidates in 3D Torus adaptive routing - "
               "should be at destination");
     }
@@ -459,32 +505,28 @@ RoutingUnit::outportComputeTorus3DAdaptive(RouteInfo route,
     if (t_flit->get_use_escape_vc()) {
         // Currently using escape VC - must continue using escape VCs
         // Use deterministic dimension-order routing
-        PortDirection escape_direction = computeEscapeVCDirection(my_x, my_y, my_z, 
-                                                                 dest_x, dest_y, dest_z, 
-                                                                 dim_x, dim_y, dim_z);
-        // Validate the selected direction
-        if (m_outports_dirn2idx.find(escape_direction) ==
-            m_outports_dirn2idx.end()) {
-            panic("3D Torus adaptive routing: escape direction %s not found "
-                  "in router %d",
-                  escape_direction.c_str(), m_router->get_id());
-        }
-        return m_outports_dirn2idx[escape_direction];
+        return getOutportForDirection(entry.escape_dirn);
     }
-    PortDirection best_direction = "Unknown";
+    PortDirectionId best_direction = OTHER_DIRN_;
 
     // First, try adaptive routing on available adaptive candidates
     // Check congestion and VC availability for adaptive directions
     float best_score = FLT_MAX;
     bool found_adaptive_path = false;
-    std::vector<PortDirection> tie_candidates;  // Directions with same best score
-
-    for (const auto& direction : adaptive_candidates) {
-        if (m_outports_dirn2idx.find(direction) == m_outports_dirn2idx.end()) {
-            continue;  // Skip if direction not available
+    // Directions with same best score
+    PortDirectionMask tie_candidates = 0;
+
+    // Candidates are visited in X, Y, Z order
+    for (int d = EAST_; d <= DOWN_; d++) {
+        PortDirectionId direction = (PortDirectionId)d;
+        if (!(adaptive_candidates & dirnBit(direction))) {
+            continue;
         }
 
         int outport_idx = m_outports_dirn2idx[direction];
+        if (outport_idx == -1) {
+            continue;  // Skip if direction not available
+        }
 
         // Check if this outport has available adaptive VCs (VCs 1+)
         // Simple heuristic: assume adaptive VCs are available with some
@@ -497,76 +539,45 @@ RoutingUnit::outportComputeTorus3DAdaptive(RouteInfo route,
             float combined_score = calculateCombinedScore(outport_idx,
                                                          direction,
                                                          route.vnet,
-                                                         route.dest_ni);
+                                                         route.dest_router);
 
             if (combined_score < best_score) {
                 best_score = combined_score;
                 best_direction = direction;
                 found_adaptive_path = true;
-                tie_candidates.clear();
-                tie_candidates.push_back(direction);
+                tie_candidates = dirnBit(direction);
             } else if (abs(combined_score - best_score) < 0.001f && found_adaptive_path) {
                 // Same score - add to tie candidates
-                tie_candidates.push_back(direction);
+                tie_candidates |= dirnBit(direction);
             }
         }
     }
     // t_flit->set_use_escape_vc(true);
     // Handle tie-breaking if multiple directions have the same best score
-    if (found_adaptive_path && tie_candidates.size() > 1) {
-        std::string tie_breaking_strategy = garnet_net->getAdaptiveTieBreaking();
+    if (found_adaptive_path) {
+        // A single candidate is returned as is
         best_direction = applyTieBreakingStrategy(tie_candidates,
-                                                tie_breaking_strategy,
-                                                adaptive_candidates);
-    } else if (found_adaptive_path && tie_candidates.size() == 1) {
-        // Single adaptive path found
-        best_direction = tie_candidates[0];
+                             m_net_ptr->getAdaptiveTieBreaking());
     }
 
     // If no adaptive path found, use escape VCs with deterministic routing
     if (!found_adaptive_path) {
     // if (true){
         // Use mesh-style escape VC routing (no wrap-around edges)
-        best_direction = computeEscapeVCDirection(my_x, my_y, my_z, 
-                                                 dest_x, dest_y, dest_z, 
-                                                 dim_x, dim_y, dim_z);
+        best_direction = entry.escape_dirn;
         t_flit->set_use_escape_vc(true); // Using escape VC
     }
 
-    // Validate the selected direction
-    if (m_outports_dirn2idx.find(best_direction) ==
-        m_outports_dirn2idx.end()) {
-        panic("3D Torus adaptive routing: selected direction %s not found "
-              "in router %d",
-              best_direction.c_str(), m_router->get_id());
-    }
-    return m_outports_dirn2idx[best_direction];
+    return getOutportForDirection(best_direction);
 }
 
 // Helper function to check if adaptive VCs are available for a specific virtual network
 bool
 RoutingUnit::checkAdaptiveVCAvailabilityForVnet(int outport_idx, int vnet)
 {
-    // Access the router's output unit for this outport
-    auto output_unit = m_router->getOutputUnit(outport_idx);
-
-    int vcs_per_vnet = output_unit->getVcsPerVnet();
-
     // Check only adaptive VCs (escape_vcs+) for the specific virtual network
-    GarnetNetwork* garnet_net = safe_cast<GarnetNetwork*>(m_router->get_net_ptr());
-    uint32_t escape_vcs = garnet_net->getEscapeVCs();
-    
-    for (int vc_offset = escape_vcs; vc_offset < vcs_per_vnet; vc_offset++) {
-        int vc_id = vnet * vcs_per_vnet + vc_offset;
-
-        // During route computation, check if VC is idle for this specific vnet
-        if (output_unit->is_vc_idle(vc_id, curTick())) {
-            // Found at least one available adaptive VC for this vnet
-            return true;
-        }
-    }
-
-    return false; // No adaptive VCs available for this specific vnet
+    auto output_unit = m_router->getOutputUnit(outport_idx);
+    return output_unit->count_free_vcs(vnet, false) > 0;
 }
 
 // Helper function to check if adaptive VCs are available for an outport (legacy)
@@ -616,31 +627,18 @@ RoutingUnit::checkAdaptiveVCAvailabilityForVnet(int outport_idx, int vnet)
 // Helper function to calculate congestion score for a specific virtual network
 int
 RoutingUnit::getDirectionCongestionScoreForVnet(int outport_idx,
-                                               const PortDirection& direction,
+                                               PortDirectionId direction,
                                                int vnet)
 {
     // Get basic congestion information from the output unit
     auto output_unit = m_router->getOutputUnit(outport_idx);
 
-    int vcs_per_vnet = output_unit->getVcsPerVnet();
-    int idle_adaptive_vcs = 0;
-    
-    GarnetNetwork* garnet_net = safe_cast<GarnetNetwork*>(m_router->get_net_ptr());
-    uint32_t escape_vcs = garnet_net->getEscapeVCs();
-
     // Count idle adaptive VCs (escape_vcs+) for the specific virtual network
-    for (int vc_offset = escape_vcs; vc_offset < vcs_per_vnet; vc_offset++) {
-        int vc_id = vnet * vcs_per_vnet + vc_offset;
-
-        // Check if VC is idle for this specific virtual network
-        if (output_unit->is_vc_idle(vc_id, curTick())) {
-            idle_adaptive_vcs++;
-        }
-    }
+    int idle_adaptive_vcs = output_unit->count_free_vcs(vnet, false);
 
     // Simple congestion score: total adaptive VCs minus idle VCs
     // Lower score means less congestion (more idle VCs available)
-    int total_adaptive_vcs = vcs_per_vnet - escape_vcs; // Exclude escape VCs
+    int total_adaptive_vcs = output_unit->get_num_adaptive_vcs();
     int congestion_score = total_adaptive_vcs - idle_adaptive_vcs;
 
     return congestion_score;
@@ -648,147 +646,70 @@ RoutingUnit::getDirectionCongestionScoreForVnet(int outport_idx,
 
 // Calculate remaining hops after taking a specific direction
 int
-RoutingUnit::calculateRemainingHops(const PortDirection& direction, int dest_ni)
+RoutingUnit::calculateRemainingHops(PortDirectionId direction,
+                                    int dest_router)
 {
-    GarnetNetwork* garnet_net = safe_cast<GarnetNetwork*>(m_router->get_net_ptr());
-    
-    int dim_x = garnet_net->getTorusX();
-    int dim_y = garnet_net->getTorusY();
-    int dim_z = garnet_net->getTorusZ();
-    
-    // Get current router coordinates
-    int current_router_id = m_router->get_id();
-    int curr_z = current_router_id / (dim_x * dim_y);
-    int curr_remainder = current_router_id % (dim_x * dim_y);
-    int curr_y = curr_remainder / dim_x;
-    int curr_x = curr_remainder % dim_x;
-    
-    // Get destination coordinates
-    int dest_z = dest_ni / (dim_x * dim_y);
-    int dest_remainder = dest_ni % (dim_x * dim_y);
-    int dest_y = dest_remainder / dim_x;
-    int dest_x = dest_remainder % dim_x;
-    
-    // Simulate moving in the chosen direction
-    int next_x = curr_x, next_y = curr_y, next_z = curr_z;
-    
-    if (direction == "East") {
-        next_x = (curr_x + 1) % dim_x;
-    } else if (direction == "West") {
-        next_x = (curr_x - 1 + dim_x) % dim_x;
-    } else if (direction == "North") {
-        next_y = (curr_y + 1) % dim_y;
-    } else if (direction == "South") {
-        next_y = (curr_y - 1 + dim_y) % dim_y;
-    } else if (direction == "Up") {
-        next_z = (curr_z + 1) % dim_z;
-    } else if (direction == "Down") {
-        next_z = (curr_z - 1 + dim_z) % dim_z;
-    }
-    
-    // Calculate distance in each dimension considering torus wraparound
-    auto torus_distance = [](int curr, int dest, int dim_size) -> int {
-        int forward_dist = (dest - curr + dim_size) % dim_size;
-        int backward_dist = (curr - dest + dim_size) % dim_size;
-        return std::min(forward_dist, backward_dist);
-    };
-    
-    int x_dist = torus_distance(next_x, dest_x, dim_x);
-    int y_dist = torus_distance(next_y, dest_y, dim_y);
-    int z_dist = torus_distance(next_z, dest_z, dim_z);
-                         
-    return x_dist + y_dist + z_dist;
+    const TorusRoute &entry = getTorusRoute(dest_router);
+
+    if (entry.minimal_dirns & dirnBit(direction))
+        return entry.total_hops - 1;
+
+    // Simulate moving in the chosen (non-minimal) direction
+    int dim = dirnDimension(direction);
+    int step = ((direction - EAST_) % 2 == 0) ? 1 : -1;
+    int dim_size = m_torus_dims[dim];
+    int next = (m_torus_coord[dim] + step + dim_size) % dim_size;
+    // The minimal direction in this dimension (if any) is the opposite one
+    int dest = (m_torus_coord[dim] - step * entry.hops[dim] + dim_size) %
+               dim_size;
+    return entry.total_hops - entry.hops[dim] +
+           torusDistance(next, dest, dim_size).first;
 }
 
 // Calculate prefer-short score: higher values mean shorter remaining distances
 float
-RoutingUnit::calculateDistanceScore(const PortDirection& direction, int dest_ni)
+RoutingUnit::calculateDistanceScore(PortDirectionId direction,
+                                    int dest_router)
 {
-    GarnetNetwork* garnet_net = safe_cast<GarnetNetwork*>(m_router->get_net_ptr());
-    
-    int dim_x = garnet_net->getTorusX();
-    int dim_y = garnet_net->getTorusY();
-    int dim_z = garnet_net->getTorusZ();
-    
-    // Get current router coordinates
-    int current_router_id = m_router->get_id();
-    int curr_z = current_router_id / (dim_x * dim_y);
-    int curr_remainder = current_router_id % (dim_x * dim_y);
-    int curr_y = curr_remainder / dim_x;
-    int curr_x = curr_remainder % dim_x;
-    
-    // Get destination coordinates  
-    int dest_z = dest_ni / (dim_x * dim_y);
-    int dest_remainder = dest_ni % (dim_x * dim_y);
-    int dest_y = dest_remainder / dim_x;
-    int dest_x = dest_remainder % dim_x;
-    
-    // Calculate remaining distance in each dimension
-    auto torus_distance = [](int curr, int dest, int dim_size) -> int {
-        int forward_dist = (dest - curr + dim_size) % dim_size;
-        int backward_dist = (curr - dest + dim_size) % dim_size;
-        return std::min(forward_dist, backward_dist);
-    };
-    
-    int x_dist = torus_distance(curr_x, dest_x, dim_x);
-    int y_dist = torus_distance(curr_y, dest_y, dim_y);
-    int z_dist = torus_distance(curr_z, dest_z, dim_z);
-    
+    const TorusRoute &entry = getTorusRoute(dest_router);
+
     // Calculate prefer-short score for the chosen direction
     // Higher score = prefer this direction when coefficient > 0 (prefer short)
     // Lower score = prefer this direction when coefficient < 0 (prefer long)
-    float prefer_short_score = 0.0f;
-    int total_remaining = x_dist + y_dist + z_dist;
-    
+    int total_remaining = entry.total_hops;
+
     if (total_remaining == 0) {
         return 0.0f;  // Should not happen in routing
     }
-    
-    if (direction == "East" || direction == "West") {
-        if (x_dist > 0) {
-            // Score inversely proportional to remaining distance in this dimension
-            // More remaining distance = lower score = prefer when coefficient < 0
-            prefer_short_score = (float)(total_remaining - x_dist) / total_remaining;
-        } else {
-            prefer_short_score = 0.0f;  // Invalid direction
-        }
-    } else if (direction == "North" || direction == "South") {
-        if (y_dist > 0) {
-            prefer_short_score = (float)(total_remaining - y_dist) / total_remaining;
-        } else {
-            prefer_short_score = 0.0f;  // Invalid direction
-        }
-    } else if (direction == "Up" || direction == "Down") {
-        if (z_dist > 0) {
-            prefer_short_score = (float)(total_remaining - z_dist) / total_remaining;
-        } else {
-            prefer_short_score = 0.0f;  // Invalid direction
-        }
+
+    if (direction < EAST_ || direction > DOWN_) {
+        return 0.0f;
     }
-    
-    return prefer_short_score;
+
+    int dim_dist = entry.hops[dirnDimension(direction)];
+    if (dim_dist == 0) {
+        return 0.0f;  // Invalid direction
+    }
+
+    // Score inversely proportional to remaining distance in this dimension
+    // More remaining distance = lower score = prefer when coefficient < 0
+    return (float)(total_remaining - dim_dist) / total_remaining;
 }
 
 // Calculate combined congestion + distance score
 float
-RoutingUnit::calculateCombinedScore(int outport_idx, const PortDirection& direction, 
-                                   int vnet, int dest_ni)
+RoutingUnit::calculateCombinedScore(int outport_idx, PortDirectionId direction,
+                                   int vnet, int dest_router)
 {
-    GarnetNetwork* garnet_net = safe_cast<GarnetNetwork*>(m_router->get_net_ptr());
-    float distance_coefficient = garnet_net->getDistanceCoefficient();
+    float distance_coefficient = m_net_ptr->getDistanceCoefficient();
     
-    // Get normalized congestion score (0.0-1.0)
-    int congestion_raw = getDirectionCongestionScoreForVnet(outport_idx, direction, vnet);
-    auto output_unit = m_router->getOutputUnit(outport_idx);
-    int vcs_per_vnet = output_unit->getVcsPerVnet();
-    uint32_t escape_vcs = garnet_net->getEscapeVCs();
-    int total_adaptive_vcs = vcs_per_vnet - escape_vcs;
-    
-    float congestion_score = (total_adaptive_vcs > 0) ? 
-                            (float)congestion_raw / total_adaptive_vcs : 0.0f;
+    // Get normalized congestion score (0.0-1.0), maintained by the
+    // output unit as VCs are allocated and freed
+    float congestion_score =
+        m_router->getOutputUnit(outport_idx)->get_congestion(vnet);
     
     // Get prefer-short score (0.0-1.0, higher = shorter remaining distance in this dimension)
-    float prefer_short_score = calculateDistanceScore(direction, dest_ni);
+    float prefer_short_score = calculateDistanceScore(direction, dest_router);
     
     // Combined score: congestion + coefficient * prefer_short
     // Lower final score = better choice
@@ -803,7 +724,7 @@ RoutingUnit::calculateCombinedScore(int outport_idx, const PortDirection& direct
 // Legacy function for backward compatibility - now uses simple aggregate scoring
 int
 RoutingUnit::getDirectionCongestionScore(int outport_idx,
-                                        const PortDirection& direction)
+                                        PortDirectionId direction)
 {
     // Get basic congestion information from the output unit
     auto output_unit = m_router->getOutputUnit(outport_idx);
@@ -823,57 +744,43 @@ RoutingUnit::getDirectionCongestionScore(int outport_idx,
 }
 
 // Apply tie-breaking strategy when multiple directions have the same congestion score
-PortDirection
-RoutingUnit::applyTieBreakingStrategy(const std::vector<PortDirection>& tie_candidates,
-                                     const std::string& strategy,
-                                     const std::vector<PortDirection>& all_candidates)
+PortDirectionId
+RoutingUnit::applyTieBreakingStrategy(PortDirectionMask tie_candidates,
+                                     TieBreakingPolicy strategy)
 {
-    if (tie_candidates.empty()) {
+    if (tie_candidates == 0) {
         panic("Empty tie candidates in applyTieBreakingStrategy");
     }
 
-    if (tie_candidates.size() == 1) {
-        return tie_candidates[0];
+    // Directions are numbered in X, Y, Z order, so the lowest set bit
+    // is the X-first choice
+    if (popCount(tie_candidates) == 1 || strategy == X_FIRST_) {
+        return (PortDirectionId)ctz32(tie_candidates);
     }
 
-    if (strategy == "x_first") {
-        // Prefer X directions (East/West), then Y (North/South), then Z (Up/Down)
-        for (const auto& direction : {"East", "West", "North", "South", "Up", "Down"}) {
-            for (const auto& candidate : tie_candidates) {
-                if (candidate == direction) {
-                    return candidate;
-                }
-            }
-        }
-        return tie_candidates[0];  // Fallback
-
-    } else if (strategy == "z_first") {
+    if (strategy == Z_FIRST_) {
         // Prefer Z directions (Up/Down), then Y (North/South), then X (East/West)
-        for (const auto& direction : {"Up", "Down", "North", "South", "East", "West"}) {
-            for (const auto& candidate : tie_candidates) {
-                if (candidate == direction) {
-                    return candidate;
-                }
+        for (PortDirectionId direction :
+             {UP_, DOWN_, NORTH_, SOUTH_, EAST_, WEST_}) {
+            if (tie_candidates & dirnBit(direction)) {
+                return direction;
             }
         }
-        return tie_candidates[0];  // Fallback
-
-    } else if (strategy == "uniform") {
-        // Uniform random selection among tie candidates
-        int random_idx = random_mt.random(0, static_cast<int>(tie_candidates.size()) - 1);
-        return tie_candidates[random_idx];
+    }
 
-    } else {
-        // Unknown strategy - default to x_first
-        DPRINTF(RubyNetwork, "Unknown tie-breaking strategy: %s, using x_first\n",
-                strategy.c_str());
-        return applyTieBreakingStrategy(tie_candidates, "x_first", all_candidates);
+    // Uniform random selection among tie candidates
+    assert(strategy == UNIFORM_);
+    int random_idx = m_random->random(0, popCount(tie_candidates) - 1);
+    PortDirectionMask remaining = tie_candidates;
+    for (int i = 0; i < random_idx; i++) {
+        remaining &= remaining - 1;
     }
+    return (PortDirectionId)ctz32(remaining);
 }
 
 // Compute escape VC direction using mesh-style routing (no wrap-around edges)
 // This ensures deadlock-free routing by maintaining a strict ordering
-PortDirection
+PortDirectionId
 RoutingUnit::computeEscapeVCDirection(int my_x, int my_y, int my_z,
                                      int dest_x, int dest_y, int dest_z,
                                      int dim_x, int dim_y, int dim_z)
@@ -884,27 +791,27 @@ RoutingUnit::computeEscapeVCDirection(int my_x, int my_y, int my_z,
     // Route in X dimension first
     if (my_x != dest_x) {
         if (dest_x > my_x) {
-            return "East";   // Move in positive X direction
+            return EAST_;   // Move in positive X direction
         } else {
-            return "West";   // Move in negative X direction  
+            return WEST_;   // Move in negative X direction  
         }
     }
     
     // Route in Y dimension second
     if (my_y != dest_y) {
         if (dest_y > my_y) {
-            return "North";  // Move in positive Y direction
+            return NORTH_;  // Move in positive Y direction
         } else {
-            return "South";  // Move in negative Y direction
+            return SOUTH_;  // Move in negative Y direction
         }
     }
     
     // Route in Z dimension last
     if (my_z != dest_z) {
         if (dest_z > my_z) {
-            return "Up";     // Move in positive Z direction
+            return UP_;     // Move in positive Z direction
         } else {
-            return "Down";   // Move in negative Z direction
+            return DOWN_;   // Move in negative Z direction
         }
     }
     
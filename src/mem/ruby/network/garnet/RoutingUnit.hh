@@ -31,6 +31,11 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_ROUTINGUNIT_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_ROUTINGUNIT_HH__
 
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "base/random.hh"
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
@@ -53,9 +58,10 @@ class RoutingUnit
 {
   public:
     RoutingUnit(Router *router);
+    void init();
     int outportCompute(RouteInfo route,
                       int inport,
-                      PortDirection inport_dirn,
+                      PortDirectionId inport_dirn,
                       flit* t_flit);
 
     // Topology-agnostic Routing Table based routing (default)
@@ -63,31 +69,31 @@ class RoutingUnit
     void addWeight(int link_weight);
 
     // get output port from routing table
-    int  lookupRoutingTable(int vnet, NetDest net_dest);
+    int  lookupRoutingTable(int vnet, NodeID dest_node);
 
     // Topology-specific direction based routing
-    void addInDirection(PortDirection inport_dirn, int inport);
-    void addOutDirection(PortDirection outport_dirn, int outport);
+    void addInDirection(PortDirectionId inport_dirn, int inport);
+    void addOutDirection(PortDirectionId outport_dirn, int outport);
 
     // Routing for Mesh
     int outportComputeXY(RouteInfo route,
                          int inport,
-                         PortDirection inport_dirn);
+                         PortDirectionId inport_dirn);
 
     // Custom Routing Algorithm using Port Directions
     int outportComputeCustom(RouteInfo route,
                              int inport,
-                             PortDirection inport_dirn);
+                             PortDirectionId inport_dirn);
 
     // Routing for 3D Torus (Dimension-Order Routing)
     int outportComputeTorus3D(RouteInfo route,
                               int inport,
-                              PortDirection inport_dirn);
+                              PortDirectionId inport_dirn);
 
     // Adaptive Routing for 3D Torus with Duato-style Escape VC
     int outportComputeTorus3DAdaptive(RouteInfo route,
                                      int inport,
-                                     PortDirection inport_dirn,
+                                     PortDirectionId inport_dirn,
                                      flit* t_flit);
 
     // Helper functions for adaptive routing
@@ -95,43 +101,93 @@ class RoutingUnit
     // New function for virtual-network-specific VC availability check
     bool checkAdaptiveVCAvailabilityForVnet(int outport_idx, int vnet);
     int getDirectionCongestionScore(int outport_idx,
-                                    const PortDirection& direction);
+                                    PortDirectionId direction);
     // New function for packet-type-specific congestion scoring
     int getDirectionCongestionScoreForVnet(int outport_idx,
-                                           const PortDirection& direction,
+                                           PortDirectionId direction,
                                            int vnet);
-                                           
+
     // Distance-aware routing functions
-    int calculateRemainingHops(const PortDirection& direction, int dest_ni);
-    float calculateDistanceScore(const PortDirection& direction, int dest_ni);
-    float calculateCombinedScore(int outport_idx, const PortDirection& direction, 
-                                int vnet, int dest_ni);    // Returns true if vnet is present in the vector
+    int calculateRemainingHops(PortDirectionId direction, int dest_router);
+    float calculateDistanceScore(PortDirectionId direction, int dest_router);
+    float calculateCombinedScore(int outport_idx, PortDirectionId direction,
+                                 int vnet, int dest_router);
+
+    // Returns true if vnet is present in the vector
     // of vnets or if the vector supports all vnets.
     bool supportsVnet(int vnet, std::vector<int> sVnets);
 
     // Apply tie-breaking strategy for adaptive routing
-    PortDirection applyTieBreakingStrategy(const std::vector<PortDirection>& tie_candidates,
-                                          const std::string& strategy,
-                                          const std::vector<PortDirection>& all_candidates);
+    PortDirectionId applyTieBreakingStrategy(PortDirectionMask tie_candidates,
+                                            TieBreakingPolicy strategy);
 
     // Escape VC routing function (mesh-style, no wrap-around)
-    PortDirection computeEscapeVCDirection(int my_x, int my_y, int my_z,
-                                          int dest_x, int dest_y, int dest_z,
-                                          int dim_x, int dim_y, int dim_z);
+    PortDirectionId computeEscapeVCDirection(int my_x, int my_y, int my_z,
+                                            int dest_x, int dest_y,
+                                            int dest_z, int dim_x,
+                                            int dim_y, int dim_z);
 
 
   private:
+    // Routing information towards one destination router of a 3D torus
+    struct TorusRoute
+    {
+        // Directions on a shortest path, at most one per dimension
+        PortDirectionMask minimal_dirns;
+        // Mesh-style dimension-order direction used on the escape VCs
+        PortDirectionId escape_dirn;
+        // Remaining hops in each dimension (X, Y, Z) and in total
+        uint16_t hops[3];
+        uint16_t total_hops;
+    };
+
+    const TorusRoute &getTorusRoute(int dest_router) const;
+
+    // Outport for a direction, panics if the router has none
+    int getOutportForDirection(PortDirectionId dirn);
+
     Router *m_router;
+    // Network of the router, cached in init() for the per-flit routing
+    GarnetNetwork *m_net_ptr;
+
+    // Builds the candidate outports of every (vnet, destination node)
+    void buildRouteCandidates();
 
     // Routing Table
     std::vector<std::vector<NetDest>> m_routing_table;
     std::vector<int> m_weight_table;
 
-    // Inport and Outport direction to idx maps
-    std::map<PortDirection, int> m_inports_dirn2idx;
-    std::map<int, PortDirection> m_inports_idx2dirn;
-    std::map<int, PortDirection> m_outports_idx2dirn;
-    std::map<PortDirection, int> m_outports_dirn2idx;
+    // Minimum-weight outports towards each destination node, built from
+    // the routing table in init(), which is then released. A router only
+    // sees a few distinct sets of candidate outports, so each set is
+    // stored once: set s is m_candidate_outports[m_candidate_sets[s]]
+    // up to, but excluding, m_candidate_sets[s + 1]. The set of (vnet,
+    // node) is m_route_sets[m_vnet_routes[vnet]][node], and vnets with
+    // the same routes share their entry of m_route_sets. This takes two
+    // bytes per destination node and distinct vnet in each router.
+    int m_num_route_nodes;
+    std::vector<int> m_vnet_routes;
+    std::vector<std::vector<uint16_t>> m_route_sets;
+    std::vector<uint32_t> m_candidate_sets;
+    std::vector<uint8_t> m_candidate_outports;
+
+    // Inport and Outport direction to idx maps (-1 if no such port)
+    std::array<int, NUM_PORT_DIRECTION_> m_inports_dirn2idx;
+    std::vector<PortDirectionId> m_inports_idx2dirn;
+    std::vector<PortDirectionId> m_outports_idx2dirn;
+    std::array<int, NUM_PORT_DIRECTION_> m_outports_dirn2idx;
+
+    // 3D torus coordinates and size, and routes indexed by destination
+    // router. Only built in init() when a torus routing algorithm is used.
+    int m_torus_coord[3];
+    int m_torus_dims[3];
+    std::vector<TorusRoute> m_torus_routes;
+
+    // Source of random routing decisions: random_mt, or a generator of
+    // this router's own when the network is partitioned across event
+    // queues, so that parallel threads never share one
+    Random *m_random;
+    std::unique_ptr<Random> m_own_random;
 };
 
 } // namespace garnet
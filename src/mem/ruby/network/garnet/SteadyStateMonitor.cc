@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "mem/ruby/network/garnet/SteadyStateMonitor.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+
+#include "base/logging.hh"
+#include "debug/RubyNetwork.hh"
+#include "mem/ruby/network/garnet/GarnetNetwork.hh"
+#include "sim/sim_exit.hh"
+#include "sim/stat_control.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+namespace
+{
+
+// Two-sided 95% quantile of Student's t distribution
+double
+studentT95(int degrees)
+{
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+        2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+        2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052,
+        2.048, 2.045, 2.042
+    };
+    const int size = sizeof(table) / sizeof(table[0]);
+    assert(degrees > 0);
+    return degrees <= size ? table[degrees - 1] : 1.960;
+}
+
+} // anonymous namespace
+
+SteadyStateMonitor::SteadyStateMonitor(GarnetNetwork *net, Cycles window,
+                                       double tolerance, int warmup_windows,
+                                       double ci_target, int min_batches,
+                                       int saturation_windows)
+    : m_net(net), m_window(window), m_tolerance(tolerance),
+      m_warmup_windows(warmup_windows), m_ci_target(ci_target),
+      m_min_batches(std::max(min_batches, 2)),
+      m_saturation_windows(saturation_windows),
+      m_event([this]{ checkWindow(); }, net->name() + ".steady_state"),
+      m_warm(false), m_balanced_windows(0), m_growing_windows(0),
+      m_growth_start(0), m_injected(0), m_received(0), m_last_injected(0),
+      m_last_received(0), m_last_in_flight(0), m_window_latency(0),
+      m_num_batches(0), m_batch_mean(0), m_batch_m2(0)
+{
+    fatal_if(tolerance < 0 || ci_target <= 0, "%s: the steady state "
+             "tolerance and confidence interval must be positive",
+             net->name());
+}
+
+void
+SteadyStateMonitor::start()
+{
+    // The packet counters are updated by all the NIs
+    fatal_if(m_net->isPartitioned(), "%s: steady state detection is not "
+             "supported when the network is partitioned across event "
+             "queues.", m_net->name());
+
+    m_net->schedule(m_event, m_net->clockEdge(m_window));
+}
+
+void
+SteadyStateMonitor::checkWindow()
+{
+    uint64_t injected = m_injected - m_last_injected;
+    uint64_t received = m_received - m_last_received;
+    uint64_t in_flight = m_injected - m_received;
+
+    DPRINTF(RubyNetwork, "Steady state window: %d packets injected, %d "
+            "received, %d in flight\n", injected, received, in_flight);
+
+    if (saturated(in_flight)) {
+        inform("%s: saturated, %d packets in flight\n", m_net->name(),
+               in_flight);
+        exitSimLoop("garnet network saturated", SATURATED_);
+    } else if (!m_warm) {
+        bool balanced = injected > 0 &&
+            std::abs(double(injected) - double(received)) <=
+            m_tolerance * injected;
+        m_balanced_windows = balanced ? m_balanced_windows + 1 : 0;
+        if (m_balanced_windows >= m_warmup_windows) {
+            inform("%s: warmed up after %d cycles, resetting stats\n",
+                   m_net->name(), uint64_t(m_net->curCycle()));
+            statistics::schedStatEvent(false, true);
+            m_warm = true;
+        }
+    } else if (converged(received)) {
+        inform("%s: average packet latency converged to %.1f ticks\n",
+               m_net->name(), m_batch_mean);
+        exitSimLoop("garnet steady state reached", CONVERGED_);
+    }
+
+    m_last_injected = m_injected;
+    m_last_received = m_received;
+    m_last_in_flight = in_flight;
+    m_window_latency = 0;
+
+    m_net->schedule(m_event, m_net->clockEdge(m_window));
+}
+
+bool
+SteadyStateMonitor::saturated(uint64_t in_flight)
+{
+    if (in_flight <= m_last_in_flight) {
+        m_growing_windows = 0;
+        return false;
+    }
+    if (m_growing_windows++ == 0)
+        m_growth_start = in_flight;
+    return m_growing_windows >= m_saturation_windows &&
+        in_flight >= 2 * m_growth_start;
+}
+
+bool
+SteadyStateMonitor::converged(uint64_t received)
+{
+    if (received == 0)
+        return false;
+
+    // Welford's update with the mean latency of the window
+    double batch = m_window_latency / received;
+    m_num_batches++;
+    double delta = batch - m_batch_mean;
+    m_batch_mean += delta / m_num_batches;
+    m_batch_m2 += delta * (batch - m_batch_mean);
+
+    if (m_num_batches < m_min_batches)
+        return false;
+    double variance = m_batch_m2 / (m_num_batches - 1);
+    double half_width = studentT95(m_num_batches - 1) *
+        std::sqrt(variance / m_num_batches);
+    DPRINTF(RubyNetwork, "Steady state: latency %.1f +- %.1f after %d "
+            "batches\n", m_batch_mean, half_width, m_num_batches);
+    return half_width <= m_ci_target * m_batch_mean;
+}
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_RUBY_NETWORK_GARNET_0_STEADYSTATEMONITOR_HH__
+#define __MEM_RUBY_NETWORK_GARNET_0_STEADYSTATEMONITOR_HH__
+
+#include <cstdint>
+
+#include "base/types.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+class GarnetNetwork;
+
+// Watches the packet rates and latency of a GarnetNetwork, window by
+// window, and ends the simulation once the measurements are good
+// enough:
+//
+//  - Warmup ends after warmup_windows consecutive windows in which as
+//    many packets were ejected as injected, within tolerance. The
+//    stats are then reset, so they only cover the steady state.
+//  - The average latency of the packets ejected in each window after
+//    warmup is one batch mean. Once there are at least min_batches, the
+//    simulation exits as soon as the 95% confidence interval of their
+//    mean is narrower than ci_target of it.
+//  - At any time, a network in which the number of packets in flight
+//    kept growing for saturation_windows windows, and at least doubled
+//    since the first of them, is saturated and the simulation exits.
+class SteadyStateMonitor
+{
+  public:
+    // Exit codes of the simulation loop
+    enum ExitReason { CONVERGED_ = 1, SATURATED_ = 2 };
+
+    SteadyStateMonitor(GarnetNetwork *net, Cycles window,
+                       double tolerance, int warmup_windows,
+                       double ci_target, int min_batches,
+                       int saturation_windows);
+
+    void start();
+
+    void packetInjected() { m_injected++; }
+
+    void
+    packetReceived(Tick latency)
+    {
+        m_received++;
+        m_window_latency += latency;
+    }
+
+  private:
+    void checkWindow();
+    bool saturated(uint64_t in_flight);
+    bool converged(uint64_t received);
+
+    GarnetNetwork *m_net;
+    Cycles m_window;
+    double m_tolerance;
+    int m_warmup_windows;
+    double m_ci_target;
+    int m_min_batches;
+    int m_saturation_windows;
+    EventFunctionWrapper m_event;
+
+    bool m_warm;
+    int m_balanced_windows;
+    int m_growing_windows;
+    uint64_t m_growth_start;
+
+    // Packets since the start of the simulation
+    uint64_t m_injected;
+    uint64_t m_received;
+    uint64_t m_last_injected;
+    uint64_t m_last_received;
+    uint64_t m_last_in_flight;
+
+    // Latency of the packets received in the current window
+    double m_window_latency;
+
+    // Running mean and sum of squared deviations of the batch means
+    int m_num_batches;
+    double m_batch_mean;
+    double m_batch_m2;
+};
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_GARNET_0_STEADYSTATEMONITOR_HH__
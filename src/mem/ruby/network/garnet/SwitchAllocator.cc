@@ -31,6 +31,7 @@
 
 #include "mem/ruby/network/garnet/SwitchAllocator.hh"
 
+#include "base/bitfield.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
 #include "mem/ruby/network/garnet/InputUnit.hh"
@@ -55,6 +56,17 @@ SwitchAllocator::SwitchAllocator(Router *router)
 
     m_input_arbiter_activity = 0;
     m_output_arbiter_activity = 0;
+    m_requested_outports = 0;
+}
+
+// Index of the first bit set in mask at or after bit start, wrapping
+// around to bit 0. mask must not be empty.
+static inline int
+firstSetBitFrom(uint64_t mask, int start)
+{
+    assert(mask != 0);
+    uint64_t upper = start < 64 ? mask & (~0ULL << start) : 0;
+    return ctz64(upper ? upper : mask);
 }
 
 void
@@ -66,6 +78,7 @@ SwitchAllocator::init()
     m_round_robin_invc.resize(m_num_inports);
     m_port_requests.resize(m_num_inports);
     m_vc_winners.resize(m_num_inports);
+    m_outport_requests.assign(m_num_outports, 0);
 
     for (int i = 0; i < m_num_inports; i++) {
         m_round_robin_invc[i] = 0;
@@ -112,11 +125,16 @@ SwitchAllocator::arbitrate_inports()
 {
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
-    for (int inport = 0; inport < m_num_inports; inport++) {
-        int invc = m_round_robin_invc[inport];
+    // Only input ports and VCs that hold flits are visited, in the same
+    // round robin order as a scan over all of them.
+    for (uint64_t inports = m_router->getOccupiedInports(); inports;
+         inports &= inports - 1) {
+        int inport = ctz64(inports);
+        auto input_unit = m_router->getInputUnit(inport);
 
-        for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            auto input_unit = m_router->getInputUnit(inport);
+        for (uint64_t invcs = input_unit->getOccupiedVcs(); invcs;) {
+            int invc = firstSetBitFrom(invcs, m_round_robin_invc[inport]);
+            invcs &= ~(1ULL << invc);
 
             if (input_unit->need_stage(invc, SA_, curTick())) {
                 // This flit is in SA stage
@@ -133,14 +151,12 @@ SwitchAllocator::arbitrate_inports()
                     m_input_arbiter_activity++;
                     m_port_requests[inport] = outport;
                     m_vc_winners[inport] = invc;
+                    m_outport_requests[outport] |= 1ULL << inport;
+                    m_requested_outports |= 1ULL << outport;
 
                     break; // got one vc winner for this port
                 }
             }
-
-            invc++;
-            if (invc >= m_num_vcs)
-                invc = 0;
         }
     }
 }
@@ -165,106 +181,109 @@ SwitchAllocator::arbitrate_outports()
     // Now there are a set of input vc requests for output vcs.
     // Again do round robin arbitration on these requests
     // Independent arbiter at each output port
-    for (int outport = 0; outport < m_num_outports; outport++) {
-        int inport = m_round_robin_inport[outport];
+    // Only output ports that were requested in SA-I are visited.
+    for (uint64_t outports = m_requested_outports; outports;
+         outports &= outports - 1) {
+        int outport = ctz64(outports);
 
-        for (int inport_iter = 0; inport_iter < m_num_inports;
-                 inport_iter++) {
+        // first requesting inport in round robin order
+        int inport = firstSetBitFrom(m_outport_requests[outport],
+                                     m_round_robin_inport[outport]);
+        assert(m_port_requests[inport] == outport);
 
-            // inport has a request this cycle for outport
-            if (m_port_requests[inport] == outport) {
-                auto output_unit = m_router->getOutputUnit(outport);
-                auto input_unit = m_router->getInputUnit(inport);
+        auto output_unit = m_router->getOutputUnit(outport);
+        auto input_unit = m_router->getInputUnit(inport);
 
-                // grant this outport to this inport
-                int invc = m_vc_winners[inport];
+        // grant this outport to this inport
+        int invc = m_vc_winners[inport];
 
-                int outvc = input_unit->get_outvc(invc);
-                if (outvc == -1) {
-                    // VC Allocation - select any free VC from outport
-                    outvc = vc_allocate(outport, inport, invc, input_unit->peekTopFlit(invc));
-                }
+        int outvc = input_unit->get_outvc(invc);
+        if (outvc == -1) {
+            // VC Allocation - select any free VC from outport
+            outvc = vc_allocate(outport, inport, invc,
+                                input_unit->peekTopFlit(invc));
+        }
 
-                // remove flit from Input VC
-                flit *t_flit = input_unit->getTopFlit(invc);
-
-                DPRINTF(RubyNetwork, "SwitchAllocator at Router %d "
-                                     "granted outvc %d at outport %d "
-                                     "to invc %d at inport %d to flit %s at "
-                                     "cycle: %lld\n",
-                        m_router->get_id(), outvc,
-                        m_router->getPortDirectionName(
-                            output_unit->get_direction()),
-                        invc,
-                        m_router->getPortDirectionName(
-                            input_unit->get_direction()),
-                            *t_flit,
-                        m_router->curCycle());
-
-
-                // Update outport field in the flit since this is
-                // used by CrossbarSwitch code to send it out of
-                // correct outport.
-                // Note: post route compute in InputUnit,
-                // outport is updated in VC, but not in flit
-                t_flit->set_outport(outport);
-
-                // set outvc (i.e., invc for next hop) in flit
-                // (This was updated in VC by vc_allocate, but not in flit)
-                t_flit->set_vc(outvc);
-
-                // decrement credit in outvc
-                output_unit->decrement_credit(outvc);
-
-                // flit ready for Switch Traversal
-                t_flit->advance_stage(ST_, curTick());
-                m_router->grant_switch(inport, t_flit);
-                m_output_arbiter_activity++;
-
-                if ((t_flit->get_type() == TAIL_) ||
-                    t_flit->get_type() == HEAD_TAIL_) {
-
-                    // This Input VC should now be empty
-                    assert(!(input_unit->isReady(invc, curTick())));
-
-                    // Free this VC
-                    // printf("[SwitchAllocator Debug] Router %d: Setting input VC %d to IDLE (flit type %d)\n", 
-                    //        m_router->get_id(), invc, t_flit->get_type());
-                    input_unit->set_vc_idle(invc, curTick());
-
-                    // Send a credit back
-                    // along with the information that this VC is now idle
-                    input_unit->increment_credit(invc, true, curTick());
-                } else {
-                    // Send a credit back
-                    // but do not indicate that the VC is idle
-                    input_unit->increment_credit(invc, false, curTick());
-                }
+        // remove flit from Input VC
+        flit *t_flit = input_unit->getTopFlit(invc);
+
+        DPRINTF(RubyNetwork, "SwitchAllocator at Router %d "
+                             "granted outvc %d at outport %d "
+                             "to invc %d at inport %d to flit %s at "
+                             "cycle: %lld\n",
+                m_router->get_id(), outvc,
+                m_router->getPortDirectionName(
+                    output_unit->get_direction()),
+                invc,
+                m_router->getPortDirectionName(
+                    input_unit->get_direction()),
+                    *t_flit,
+                m_router->curCycle());
+
+
+        // Update outport field in the flit since this is
+        // used by CrossbarSwitch code to send it out of
+        // correct outport.
+        // Note: post route compute in InputUnit,
+        // outport is updated in VC, but not in flit
+        t_flit->set_outport(outport);
+
+        // Route the packet at the next router while it traverses the
+        // switch and link, so that it can skip route computation there
+        if (m_router->lookahead_routing() &&
+            (t_flit->get_type() == HEAD_ ||
+             t_flit->get_type() == HEAD_TAIL_)) {
+            t_flit->set_lookahead_outport(
+                m_router->lookahead_route(outport, t_flit));
+        }
 
-                // remove this request
-                m_port_requests[inport] = -1;
+        // set outvc (i.e., invc for next hop) in flit
+        // (This was updated in VC by vc_allocate, but not in flit)
+        t_flit->set_vc(outvc);
 
-                // Update Round Robin pointer
-                m_round_robin_inport[outport] = inport + 1;
-                if (m_round_robin_inport[outport] >= m_num_inports)
-                    m_round_robin_inport[outport] = 0;
+        // decrement credit in outvc
+        output_unit->decrement_credit(outvc);
 
-                // Update Round Robin pointer to the next VC
-                // We do it here to keep it fair.
-                // Only the VC which got switch traversal
-                // is updated.
-                m_round_robin_invc[inport] = invc + 1;
-                if (m_round_robin_invc[inport] >= m_num_vcs)
-                    m_round_robin_invc[inport] = 0;
+        // flit ready for Switch Traversal
+        t_flit->advance_stage(ST_, curTick());
+        m_router->grant_switch(inport, t_flit);
+        m_output_arbiter_activity++;
 
+        if ((t_flit->get_type() == TAIL_) ||
+            t_flit->get_type() == HEAD_TAIL_) {
 
-                break; // got a input winner for this outport
-            }
+            // This Input VC should now be empty
+            assert(!(input_unit->isReady(invc, curTick())));
+
+            // Free this VC
+            // printf("[SwitchAllocator Debug] Router %d: Setting input VC %d to IDLE (flit type %d)\n", 
+            //        m_router->get_id(), invc, t_flit->get_type());
+            input_unit->set_vc_idle(invc, curTick());
 
-            inport++;
-            if (inport >= m_num_inports)
-                inport = 0;
+            // Send a credit back
+            // along with the information that this VC is now idle
+            input_unit->increment_credit(invc, true, curTick());
+        } else {
+            // Send a credit back
+            // but do not indicate that the VC is idle
+            input_unit->increment_credit(invc, false, curTick());
         }
+
+        // remove this request
+        m_port_requests[inport] = -1;
+
+        // Update Round Robin pointer
+        m_round_robin_inport[outport] = inport + 1;
+        if (m_round_robin_inport[outport] >= m_num_inports)
+            m_round_robin_inport[outport] = 0;
+
+        // Update Round Robin pointer to the next VC
+        // We do it here to keep it fair.
+        // Only the VC which got switch traversal
+        // is updated.
+        m_round_robin_invc[inport] = invc + 1;
+        if (m_round_robin_invc[inport] >= m_num_vcs)
+            m_round_robin_invc[inport] = 0;
     }
 }
 
@@ -465,9 +484,13 @@ SwitchAllocator::check_for_wakeup()
         return;
     }
 
-    for (int i = 0; i < m_num_inports; i++) {
-        for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
+    // Flits can only be waiting for SA in occupied VCs
+    for (uint64_t inports = m_router->getOccupiedInports(); inports;
+         inports &= inports - 1) {
+        auto input_unit = m_router->getInputUnit(ctz64(inports));
+        for (uint64_t invcs = input_unit->getOccupiedVcs(); invcs;
+             invcs &= invcs - 1) {
+            if (input_unit->need_stage(ctz64(invcs), SA_, nextCycle)) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
@@ -490,6 +513,11 @@ void
 SwitchAllocator::clear_request_vector()
 {
     std::fill(m_port_requests.begin(), m_port_requests.end(), -1);
+    for (uint64_t outports = m_requested_outports; outports;
+         outports &= outports - 1) {
+        m_outport_requests[ctz64(outports)] = 0;
+    }
+    m_requested_outports = 0;
 }
 
 void
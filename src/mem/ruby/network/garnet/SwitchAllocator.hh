@@ -93,6 +93,11 @@ class SwitchAllocator : public Consumer
     std::vector<int> m_round_robin_inport;
     std::vector<int> m_port_requests;
     std::vector<int> m_vc_winners;
+
+    // Requests placed in SA-I, as bitmasks: the output ports requested
+    // this cycle, and for each of them the requesting input ports
+    uint64_t m_requested_outports;
+    std::vector<uint64_t> m_outport_requests;
 };
 
 } // namespace garnet
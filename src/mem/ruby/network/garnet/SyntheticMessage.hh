@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __MEM_RUBY_NETWORK_GARNET_0_SYNTHETICMESSAGE_HH__
+#define __MEM_RUBY_NETWORK_GARNET_0_SYNTHETICMESSAGE_HH__
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+#include "base/types.hh"
+#include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/common/TypeDefines.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace garnet
+{
+
+// Told by the network interfaces when its synthetic packets are ejected
+class SyntheticTrafficClient
+{
+  public:
+    virtual ~SyntheticTrafficClient() = default;
+    virtual void packetDelivered(uint64_t id) = 0;
+};
+
+// Protocol-free message injected directly into a network interface for
+// synthetic network studies. It carries no data; only its destination
+// node and its size in bytes matter to the network.
+class SyntheticMessage : public Message
+{
+  public:
+    // destination is shared by all the messages sent to dest_node and
+    // must outlive them. A client, if any, is told of the ejection of
+    // the packet with its id.
+    SyntheticMessage(Tick curTime, NodeID dest_node, NetDest *destination,
+                     int size, SyntheticTrafficClient *client = nullptr,
+                     uint64_t id = 0)
+        : Message(curTime), m_dest_node(dest_node),
+          m_destination(destination), m_size(size), m_client(client),
+          m_id(id)
+    {}
+
+    MsgPtr
+    clone() const override
+    {
+        return std::make_shared<SyntheticMessage>(*this);
+    }
+
+    void
+    print(std::ostream& out) const override
+    {
+        out << "[SyntheticMessage: dest=" << m_dest_node
+            << " size=" << m_size << "]";
+    }
+
+    // Synthetic messages are unicast, so the destination is never
+    // modified through this
+    const NetDest &getDestination() const override { return *m_destination; }
+    NetDest &getDestination() override { return *m_destination; }
+
+    NodeID getDestNode() const { return m_dest_node; }
+    int getSize() const { return m_size; }
+
+    void
+    delivered() const
+    {
+        if (m_client)
+            m_client->packetDelivered(m_id);
+    }
+
+    // No data to read or write
+    bool functionalRead(Packet *pkt) override { return false; }
+    bool
+    functionalRead(Packet *pkt, WriteMask &mask) override
+    {
+        return false;
+    }
+    bool functionalWrite(Packet *pkt) override { return false; }
+
+  private:
+    NodeID m_dest_node;
+    NetDest *m_destination;
+    int m_size;
+    SyntheticTrafficClient *m_client;
+    uint64_t m_id;
+};
+
+} // namespace garnet
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_GARNET_0_SYNTHETICMESSAGE_HH__
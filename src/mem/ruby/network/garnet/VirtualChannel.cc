@@ -40,8 +40,8 @@ namespace ruby
 namespace garnet
 {
 
-VirtualChannel::VirtualChannel()
-  : inputBuffer(), m_vc_state(IDLE_, Tick(0)), m_output_port(-1),
+VirtualChannel::VirtualChannel(int num_buffers)
+  : inputBuffer(num_buffers), m_vc_state(IDLE_, Tick(0)), m_output_port(-1),
     m_enqueue_time(INFINITE_), m_output_vc(-1)
 {
 }
@@ -49,7 +49,7 @@ namespace garnet
 class VirtualChannel
 {
   public:
-    VirtualChannel();
+    VirtualChannel(int num_buffers);
     ~VirtualChannel() = default;
 
     bool need_stage(flit_stage stage, Tick time);
@@ -70,6 +70,9 @@ class VirtualChannel
         return inputBuffer.isReady(curTime);
     }
 
+    inline bool isEmpty() { return inputBuffer.isEmpty(); }
+    inline int get_occupancy() const { return inputBuffer.getSize(); }
+
     inline void
     insertFlit(flit *t_flit)
     {
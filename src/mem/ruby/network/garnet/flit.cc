@@ -32,6 +32,7 @@
 
 #include "base/intmath.hh"
 #include "debug/RubyNetwork.hh"
+#include "mem/ruby/network/garnet/FlitPool.hh"
 
 namespace gem5
 {
@@ -83,8 +84,10 @@ flit::serialize(int ser_id, int parts, uint32_t bWidth)
     int new_size = (int)divCeil((float)msgSize, (float)bWidth);
     assert(new_id < new_size);
 
-    flit *fl = new flit(m_packet_id, new_id, m_vc, m_vnet, m_route,
-                    new_size, m_msg_ptr, msgSize, bWidth, m_time);
+    assert(m_pool);
+    flit *fl = m_pool->allocFlit(m_packet_id, new_id, m_vc, m_vnet, m_route,
+                                 new_size, m_msg_ptr, msgSize, bWidth,
+                                 m_time);
     fl->set_enqueue_time(m_enqueue_time);
     fl->set_src_delay(src_delay);
     return fl;
@@ -98,8 +101,10 @@ flit::deserialize(int des_id, int num_flits, uint32_t bWidth)
     int new_size = (int)divCeil((float)msgSize, (float)bWidth);
     assert(new_id < new_size);
 
-    flit *fl = new flit(m_packet_id, new_id, m_vc, m_vnet, m_route,
-                    new_size, m_msg_ptr, msgSize, bWidth, m_time);
+    assert(m_pool);
+    flit *fl = m_pool->allocFlit(m_packet_id, new_id, m_vc, m_vnet, m_route,
+                                 new_size, m_msg_ptr, msgSize, bWidth,
+                                 m_time);
     fl->set_enqueue_time(m_enqueue_time);
     fl->set_src_delay(src_delay);
     return fl;
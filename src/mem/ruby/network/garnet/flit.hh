@@ -47,6 +47,8 @@ namespace ruby
 namespace garnet
 {
 
+class FlitPool;
+
 class flit
 {
   public:
@@ -118,7 +120,18 @@ class flit
 
     void set_use_escape_vc(bool val) { use_escape_vc = val; }
     bool get_use_escape_vc() { return use_escape_vc; }
+
+    // Outport at the next router, computed one hop ahead by lookahead
+    // routing. -1 if the next router has to compute it.
+    int get_lookahead_outport() const { return m_lookahead_outport; }
+    void set_lookahead_outport(int port) { m_lookahead_outport = port; }
+
+    // Pool this flit was allocated from
+    FlitPool *get_pool() { return m_pool; }
+
   protected:
+    friend class FlitPool;
+
     int m_packet_id;
     int m_id;
     int m_vnet;
@@ -133,6 +146,8 @@ class flit
     Tick src_delay;
     std::pair<flit_stage, Tick> m_stage;
     bool use_escape_vc = false;
+    int m_lookahead_outport = -1;
+    FlitPool *m_pool = nullptr;
 };
 
 inline std::ostream&
@@ -31,6 +31,8 @@
 
 #include "mem/ruby/network/garnet/flitBuffer.hh"
 
+#include "base/intmath.hh"
+
 namespace gem5
 {
 
@@ -43,23 +45,47 @@ namespace garnet
 flitBuffer::flitBuffer()
 {
     max_size = INFINITE_;
+    allocate(defaultCapacity);
 }
 
 flitBuffer::flitBuffer(int maximum_size)
 {
     max_size = maximum_size;
+    allocate(maximum_size);
+}
+
+void
+flitBuffer::allocate(int capacity)
+{
+    m_buffer.assign(1 << ceilLog2(std::max(capacity, 1)), nullptr);
+    m_head = 0;
+    m_size = 0;
+    m_mask = m_buffer.size() - 1;
+}
+
+void
+flitBuffer::grow()
+{
+    // Unroll the ring into a buffer twice as large
+    std::vector<flit *> new_buffer(2 * m_buffer.size(), nullptr);
+    for (int i = 0; i < m_size; i++) {
+        new_buffer[i] = at(i);
+    }
+    m_buffer.swap(new_buffer);
+    m_head = 0;
+    m_mask = m_buffer.size() - 1;
 }
 
 bool
 flitBuffer::isEmpty()
 {
-    return (m_buffer.size() == 0);
+    return (m_size == 0);
 }
 
 bool
 flitBuffer::isReady(Tick curTime)
 {
-    if (m_buffer.size() != 0 ) {
+    if (m_size != 0 ) {
         flit *t_flit = peekTopFlit();
         if (t_flit->get_time() <= curTime)
             return true;
@@ -70,27 +96,29 @@ flitBuffer::isReady(Tick curTime)
 void
 flitBuffer::print(std::ostream& out) const
 {
-    out << "[flitBuffer: " << m_buffer.size() << "] " << std::endl;
+    out << "[flitBuffer: " << m_size << "] " << std::endl;
 }
 
 bool
 flitBuffer::isFull()
 {
-    return (m_buffer.size() >= max_size);
+    return (m_size >= max_size);
 }
 
 void
 flitBuffer::setMaxSize(int maximum)
 {
     max_size = maximum;
+    while (m_buffer.size() < maximum)
+        grow();
 }
 
 bool
 flitBuffer::functionalRead(Packet *pkt, WriteMask &mask)
 {
     bool read = false;
-    for (unsigned int i = 0; i < m_buffer.size(); ++i) {
-        if (m_buffer[i]->functionalRead(pkt, mask)) {
+    for (unsigned int i = 0; i < m_size; ++i) {
+        if (at(i)->functionalRead(pkt, mask)) {
             read = true;
         }
     }
@@ -103,8 +131,8 @@ flitBuffer::functionalWrite(Packet *pkt)
 {
     uint32_t num_functional_writes = 0;
 
-    for (unsigned int i = 0; i < m_buffer.size(); ++i) {
-        if (m_buffer[i]->functionalWrite(pkt)) {
+    for (unsigned int i = 0; i < m_size; ++i) {
+        if (at(i)->functionalWrite(pkt)) {
             num_functional_writes++;
         }
     }
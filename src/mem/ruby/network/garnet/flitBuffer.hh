@@ -47,6 +47,10 @@ namespace ruby
 namespace garnet
 {
 
+// Flits are kept in a contiguous power-of-two sized ring. Buffers that
+// know their size (e.g. the VC input buffers, bounded by credits) never
+// allocate after construction; the others start small and grow by
+// doubling the first few times they fill up.
 class flitBuffer
 {
   public:
@@ -58,33 +62,49 @@ class flitBuffer
     void print(std::ostream& out) const;
     bool isFull();
     void setMaxSize(int maximum);
-    int getSize() const { return m_buffer.size(); }
+    int getSize() const { return m_size; }
 
     flit *
     getTopFlit()
     {
-        flit *f = m_buffer.front();
-        m_buffer.pop_front();
+        assert(m_size > 0);
+        flit *f = m_buffer[m_head];
+        m_head = (m_head + 1) & m_mask;
+        m_size--;
         return f;
     }
 
     flit *
     peekTopFlit()
     {
-        return m_buffer.front();
+        assert(m_size > 0);
+        return m_buffer[m_head];
     }
 
     void
     insert(flit *flt)
     {
-        m_buffer.push_back(flt);
+        if (m_size == m_buffer.size())
+            grow();
+        m_buffer[(m_head + m_size) & m_mask] = flt;
+        m_size++;
     }
 
     bool functionalRead(Packet *pkt, WriteMask &mask);
     uint32_t functionalWrite(Packet *pkt);
 
   private:
-    std::deque<flit *> m_buffer;
+    // Initial ring capacity of buffers without a size limit
+    static const int defaultCapacity = 4;
+
+    void allocate(int capacity);
+    void grow();
+    flit *at(int idx) const { return m_buffer[(m_head + idx) & m_mask]; }
+
+    std::vector<flit *> m_buffer;
+    size_t m_head;
+    size_t m_size;
+    size_t m_mask;
     int max_size;
 };
 
@@ -57,6 +57,7 @@ AbstractCacheEntry::AbstractCacheEntry() : ReplaceableEntry()
     m_last_touch_tick = 0;
     m_htmInReadSet = false;
     m_htmInWriteSet = false;
+    m_tag_permission = nullptr;
 }
 
 AbstractCacheEntry::~AbstractCacheEntry()
@@ -74,6 +75,8 @@ void
 AbstractCacheEntry::changePermission(AccessPermission new_perm)
 {
     m_Permission = new_perm;
+    if (m_tag_permission)
+        *m_tag_permission = new_perm;
     if ((new_perm == AccessPermission_Invalid) ||
         (new_perm == AccessPermission_NotPresent)) {
         m_locked = -1;
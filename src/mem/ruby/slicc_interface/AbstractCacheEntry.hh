@@ -45,6 +45,7 @@
 #ifndef __MEM_RUBY_SLICC_INTERFACE_ABSTRACTCACHEENTRY_HH__
 #define __MEM_RUBY_SLICC_INTERFACE_ABSTRACTCACHEENTRY_HH__
 
+#include <cstdint>
 #include <iostream>
 
 #include "base/logging.hh"
@@ -73,6 +74,14 @@ class AbstractCacheEntry : public ReplaceableEntry
     AccessPermission getPermission() const;
     void changePermission(AccessPermission new_perm);
 
+    // The CacheMemory holding the entry keeps a copy of its permission
+    // beside its tag, updated by changePermission()
+    void
+    setTagPermission(uint8_t *tag_permission)
+    {
+        m_tag_permission = tag_permission;
+    }
+
     using ReplaceableEntry::print;
     virtual void print(std::ostream& out) const = 0;
 
@@ -126,6 +135,8 @@ class AbstractCacheEntry : public ReplaceableEntry
     // hardware transactional memory
     bool m_htmInReadSet;
     bool m_htmInWriteSet;
+
+    uint8_t *m_tag_permission;
 };
 
 inline std::ostream&
@@ -41,6 +41,8 @@
 
 #include "mem/ruby/structures/CacheMemory.hh"
 
+#include <cstring>
+
 #include "base/compiler.hh"
 #include "base/intmath.hh"
 #include "base/logging.hh"
@@ -97,8 +99,13 @@ CacheMemory::init()
     m_cache_num_set_bits = floorLog2(m_cache_num_sets);
     assert(m_cache_num_set_bits > 0);
 
-    m_cache.resize(m_cache_num_sets,
-                    std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+    static_assert(AccessPermission_NUM <= 256,
+                  "permissions must fit the tag store");
+    m_set_stride = roundUp(m_cache_assoc, TagGroup);
+    const size_t num_blocks = (size_t)m_cache_num_sets * m_set_stride;
+    m_tags.assign(num_blocks, InvalidTag);
+    m_permissions.assign(num_blocks, AccessPermission_NotPresent);
+    m_entries.assign(num_blocks, nullptr);
     replacement_data.resize(m_cache_num_sets,
                                std::vector<ReplData>(m_cache_assoc, nullptr));
     // instantiate all the replacement_data here
@@ -114,11 +121,8 @@ CacheMemory::~CacheMemory()
 {
     if (m_replacementPolicy_ptr)
         delete m_replacementPolicy_ptr;
-    for (int i = 0; i < m_cache_num_sets; i++) {
-        for (int j = 0; j < m_cache_assoc; j++) {
-            delete m_cache[i][j];
-        }
-    }
+    for (AbstractCacheEntry *entry : m_entries)
+        delete entry;
 }
 
 // convert a Address to its location in the cache
@@ -136,13 +140,7 @@ int
 CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
     assert(tag == makeLineAddress(tag));
-    // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
-    return -1; // Not found
+    return findWay(cacheSet, tag, false);
 }
 
 // Given a cache index: returns the index of the tag in a set.
@@ -152,11 +150,51 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
                                            Addr tag) const
 {
     assert(tag == makeLineAddress(tag));
-    // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        return it->second;
-    return -1; // Not found
+    return findWay(cacheSet, tag, true);
+}
+
+// Compares the tag with TagGroup ways of the set at a time, without
+// branches so that the compiler can vectorize the comparison. Ways
+// holding a NotPresent entry only match when ignoring permissions, and
+// if no other way matches.
+int
+CacheMemory::findWay(int64_t cacheSet, Addr tag,
+                     bool ignore_permissions) const
+{
+    const Addr *tags = &m_tags[blockIndex(cacheSet, 0)];
+    const uint8_t *perms = &m_permissions[blockIndex(cacheSet, 0)];
+    int not_present = -1;
+
+    for (int base = 0; base < m_set_stride; base += TagGroup) {
+        uint8_t hit[TagGroup];
+        uint8_t stale[TagGroup];
+        for (int i = 0; i < TagGroup; i++) {
+            const bool match = tags[base + i] == tag;
+            const bool present =
+                perms[base + i] != AccessPermission_NotPresent;
+            hit[i] = match & present;
+            stale[i] = match & !present;
+        }
+
+        uint64_t any_hit;
+        uint64_t any_stale;
+        static_assert(sizeof(any_hit) == TagGroup);
+        memcpy(&any_hit, hit, sizeof(any_hit));
+        memcpy(&any_stale, stale, sizeof(any_stale));
+        if (any_hit) {
+            for (int i = 0; i < TagGroup; i++) {
+                if (hit[i])
+                    return base + i;
+            }
+        }
+        if (any_stale && not_present == -1) {
+            for (int i = 0; not_present == -1; i++) {
+                if (stale[i])
+                    not_present = base + i;
+            }
+        }
+    }
+    return ignore_permissions ? not_present : -1;
 }
 
 // Given an unique cache block identifier (idx): return the valid address
@@ -173,13 +211,12 @@ CacheMemory::getAddressAtIdx(int idx) const
     int way = idx - set * m_cache_assoc;
     assert (way < m_cache_assoc);
 
-    AbstractCacheEntry* entry = m_cache[set][way];
-    if (entry == NULL ||
-        entry->m_Permission == AccessPermission_Invalid ||
-        entry->m_Permission == AccessPermission_NotPresent) {
+    const size_t block = blockIndex(set, way);
+    if (m_permissions[block] == AccessPermission_Invalid ||
+        m_permissions[block] == AccessPermission_NotPresent) {
         return tmp;
     }
-    return entry->m_Address;
+    return m_tags[block];
 }
 
 bool
@@ -249,16 +286,13 @@ CacheMemory::cacheAvail(Addr address) const
     assert(address == makeLineAddress(address));
 
     int64_t cacheSet = addressToCacheSet(address);
+    const size_t first = blockIndex(cacheSet, 0);
 
     for (int i = 0; i < m_cache_assoc; i++) {
-        AbstractCacheEntry* entry = m_cache[cacheSet][i];
-        if (entry != NULL) {
-            if (entry->m_Address == address ||
-                entry->m_Permission == AccessPermission_NotPresent) {
-                // Already in the cache or we found an empty entry
-                return true;
-            }
-        } else {
+        // Empty ways are NotPresent too
+        if (m_tags[first + i] == address ||
+            m_permissions[first + i] == AccessPermission_NotPresent) {
+            // Already in the cache or we found an empty entry
             return true;
         }
     }
@@ -275,26 +309,31 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
 
     // Find the first open slot
     int64_t cacheSet = addressToCacheSet(address);
-    std::vector<AbstractCacheEntry*> &set = m_cache[cacheSet];
+    const size_t first = blockIndex(cacheSet, 0);
     for (int i = 0; i < m_cache_assoc; i++) {
-        if (!set[i] || set[i]->m_Permission == AccessPermission_NotPresent) {
-            if (set[i] && (set[i] != entry)) {
+        if (m_permissions[first + i] == AccessPermission_NotPresent) {
+            AbstractCacheEntry *&slot = m_entries[first + i];
+            if (slot && (slot != entry)) {
                 warn_once("This protocol contains a cache entry handling bug: "
                     "Entries in the cache should never be NotPresent! If\n"
                     "this entry (%#x) is not tracked elsewhere, it will memory "
                     "leak here. Fix your protocol to eliminate these!",
                     address);
+                // The old entry no longer owns this way of the tag store
+                slot->setTagPermission(nullptr);
             }
-            set[i] = entry;  // Init entry
-            set[i]->m_Address = address;
-            set[i]->m_Permission = AccessPermission_Invalid;
+            slot = entry;  // Init entry
+            slot->m_Address = address;
+            slot->m_Permission = AccessPermission_Invalid;
             DPRINTF(RubyCache, "Allocate clearing lock for addr: %x\n",
                     address);
-            set[i]->m_locked = -1;
-            m_tag_index[address] = i;
-            set[i]->setPosition(cacheSet, i);
-            set[i]->replacementData = replacement_data[cacheSet][i];
-            set[i]->setLastAccess(curTick());
+            slot->m_locked = -1;
+            m_tags[first + i] = address;
+            m_permissions[first + i] = AccessPermission_Invalid;
+            slot->setTagPermission(&m_permissions[first + i]);
+            slot->setPosition(cacheSet, i);
+            slot->replacementData = replacement_data[cacheSet][i];
+            slot->setLastAccess(curTick());
 
             // Call reset function here to set initial value for different
             // replacement policies.
@@ -316,8 +355,10 @@ CacheMemory::deallocate(Addr address)
     uint32_t cache_set = entry->getSet();
     uint32_t way = entry->getWay();
     delete entry;
-    m_cache[cache_set][way] = NULL;
-    m_tag_index.erase(address);
+    const size_t block = blockIndex(cache_set, way);
+    m_entries[block] = nullptr;
+    m_tags[block] = InvalidTag;
+    m_permissions[block] = AccessPermission_NotPresent;
 }
 
 // Returns with the physical address of the conflicting cache line
@@ -331,10 +372,10 @@ CacheMemory::cacheProbe(Addr address) const
     std::vector<ReplaceableEntry*> candidates;
     for (int i = 0; i < m_cache_assoc; i++) {
         candidates.push_back(static_cast<ReplaceableEntry*>(
-                                                       m_cache[cacheSet][i]));
+                                                   entryAt(cacheSet, i)));
     }
-    return m_cache[cacheSet][m_replacementPolicy_ptr->
-                        getVictim(candidates)->getWay()]->m_Address;
+    return entryAt(cacheSet, m_replacementPolicy_ptr->
+                        getVictim(candidates)->getWay())->m_Address;
 }
 
 // looks an address up in the cache
@@ -345,7 +386,7 @@ CacheMemory::lookup(Addr address)
     int64_t cacheSet = addressToCacheSet(address);
     int loc = findTagInSet(cacheSet, address);
     if (loc == -1) return NULL;
-    return m_cache[cacheSet][loc];
+    return entryAt(cacheSet, loc);
 }
 
 // looks an address up in the cache
@@ -356,7 +397,7 @@ CacheMemory::lookup(Addr address) const
     int64_t cacheSet = addressToCacheSet(address);
     int loc = findTagInSet(cacheSet, address);
     if (loc == -1) return NULL;
-    return m_cache[cacheSet][loc];
+    return entryAt(cacheSet, loc);
 }
 
 // Sets the most recently used bit for a cache block
@@ -403,8 +444,8 @@ CacheMemory::getReplacementWeight(int64_t set, int64_t loc)
     assert(set < m_cache_num_sets);
     assert(loc < m_cache_assoc);
     int ret = 0;
-    if (m_cache[set][loc] != NULL) {
-        ret = m_cache[set][loc]->getNumValidBlocks();
+    if (entryAt(set, loc) != NULL) {
+        ret = entryAt(set, loc)->getNumValidBlocks();
         assert(ret >= 0);
     }
 
@@ -420,8 +461,9 @@ CacheMemory::recordCacheContents(int cntrl, CacheRecorder* tr) const
 
     for (int i = 0; i < m_cache_num_sets; i++) {
         for (int j = 0; j < m_cache_assoc; j++) {
-            if (m_cache[i][j] != NULL) {
-                AccessPermission perm = m_cache[i][j]->m_Permission;
+            AbstractCacheEntry *entry = entryAt(i, j);
+            if (entry != NULL) {
+                AccessPermission perm = entry->m_Permission;
                 RubyRequestType request_type = RubyRequestType_NULL;
                 if (perm == AccessPermission_Read_Only) {
                     if (m_is_instruction_only_cache) {
@@ -435,10 +477,10 @@ CacheMemory::recordCacheContents(int cntrl, CacheRecorder* tr) const
 
                 if (request_type != RubyRequestType_NULL) {
                     Tick lastAccessTick;
-                    lastAccessTick = m_cache[i][j]->getLastAccess();
-                    tr->addRecord(cntrl, m_cache[i][j]->m_Address,
+                    lastAccessTick = entry->getLastAccess();
+                    tr->addRecord(cntrl, entry->m_Address,
                                   0, request_type, lastAccessTick,
-                                  m_cache[i][j]->getDataBlk());
+                                  entry->getDataBlk());
                     warmedUpBlocks++;
                 }
             }
@@ -456,10 +498,10 @@ CacheMemory::print(std::ostream& out) const
     out << "Cache dump: " << name() << std::endl;
     for (int i = 0; i < m_cache_num_sets; i++) {
         for (int j = 0; j < m_cache_assoc; j++) {
-            if (m_cache[i][j] != NULL) {
+            if (entryAt(i, j) != NULL) {
                 out << "  Index: " << i
                     << " way: " << j
-                    << " entry: " << *m_cache[i][j] << std::endl;
+                    << " entry: " << *entryAt(i, j) << std::endl;
             } else {
                 out << "  Index: " << i
                     << " way: " << j
@@ -497,15 +539,11 @@ void
 CacheMemory::clearLockedAll(int context)
 {
     // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i) {
-        std::vector<AbstractCacheEntry*> set = *i;
-        for (auto j = set.begin(); j != set.end(); ++j) {
-            AbstractCacheEntry *line = *j;
-            if (line && line->isLocked(context)) {
-                DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
-                    line->m_Address);
-                line->clearLocked();
-            }
+    for (AbstractCacheEntry *line : m_entries) {
+        if (line && line->isLocked(context)) {
+            DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
+                line->m_Address);
+            line->clearLocked();
         }
     }
 }
@@ -672,13 +710,15 @@ CacheMemory::checkResourceAvailable(CacheResourceType res, Addr addr)
 bool
 CacheMemory::isBlockInvalid(int64_t cache_set, int64_t loc)
 {
-  return (m_cache[cache_set][loc]->m_Permission == AccessPermission_Invalid);
+  return (m_permissions[blockIndex(cache_set, loc)] ==
+          AccessPermission_Invalid);
 }
 
 bool
 CacheMemory::isBlockNotBusy(int64_t cache_set, int64_t loc)
 {
-  return (m_cache[cache_set][loc]->m_Permission != AccessPermission_Busy);
+  return (m_permissions[blockIndex(cache_set, loc)] !=
+          AccessPermission_Busy);
 }
 
 /* hardware transactional memory */
@@ -690,24 +730,16 @@ CacheMemory::htmAbortTransaction()
     uint64_t htmWriteSetSize = 0;
 
     // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
-
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
-
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                if (line->getInHtmWriteSet()) {
-                    line->invalidateEntry();
-                }
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
+    for (AbstractCacheEntry *line : m_entries) {
+        if (line != nullptr) {
+            htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
+            htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
+            if (line->getInHtmWriteSet()) {
+                line->invalidateEntry();
             }
+            line->setInHtmWriteSet(false);
+            line->setInHtmReadSet(false);
+            line->clearLocked();
         }
     }
 
@@ -724,20 +756,13 @@ CacheMemory::htmCommitTransaction()
     uint64_t htmWriteSetSize = 0;
 
     // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
-
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
-             }
+    for (AbstractCacheEntry *line : m_entries) {
+        if (line != nullptr) {
+            htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
+            htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
+            line->setInHtmWriteSet(false);
+            line->setInHtmReadSet(false);
+            line->clearLocked();
         }
     }
 
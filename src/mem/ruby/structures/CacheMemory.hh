@@ -42,8 +42,8 @@
 #ifndef __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
+#include <cstdint>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -167,6 +167,26 @@ class CacheMemory : public SimObject
     // returns -1 if the tag is not found.
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
+    int findWay(int64_t cacheSet, Addr tag, bool ignore_permissions) const;
+
+    // Index of a way in the tag store
+    size_t
+    blockIndex(int64_t cacheSet, int way) const
+    {
+        return (size_t)cacheSet * m_set_stride + way;
+    }
+
+    AbstractCacheEntry *&
+    entryAt(int64_t cacheSet, int way)
+    {
+        return m_entries[blockIndex(cacheSet, way)];
+    }
+
+    AbstractCacheEntry *
+    entryAt(int64_t cacheSet, int way) const
+    {
+        return m_entries[blockIndex(cacheSet, way)];
+    }
 
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
@@ -176,10 +196,17 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    // Tag store, indexed by blockIndex(): the line address and the
+    // permission of the entry in each way, side by side so that a lookup
+    // compares a whole set without touching the entries. Sets are padded
+    // to a multiple of TagGroup ways, compared together. Empty ways hold
+    // InvalidTag and AccessPermission_NotPresent.
+    static const int TagGroup = 8;
+    static const Addr InvalidTag = ~Addr(0);
+    int m_set_stride;
+    std::vector<Addr> m_tags;
+    std::vector<uint8_t> m_permissions;
+    std::vector<AbstractCacheEntry*> m_entries;
 
     /** We use the replacement policies from the Classic memory system. */
     replacement_policy::Base *m_replacementPolicy_ptr;
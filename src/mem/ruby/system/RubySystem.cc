@@ -52,6 +52,7 @@
 #include "debug/RubyCacheTrace.hh"
 #include "debug/RubySystem.hh"
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/network/Network.hh"
 #include "mem/ruby/system/DMASequencer.hh"
 #include "mem/ruby/system/Sequencer.hh"
@@ -84,6 +85,9 @@ RubySystem::RubySystem(const Params &p)
 
     m_block_size_bytes = p.block_size_bytes;
     assert(isPowerOf2(m_block_size_bytes));
+    fatal_if(m_block_size_bytes > WriteMask::MaxBytes,
+             "Ruby block size %d exceeds the %d bytes a WriteMask holds",
+             m_block_size_bytes, WriteMask::MaxBytes);
     m_block_size_bits = floorLog2(m_block_size_bytes);
     m_memory_size_bits = p.memory_size_bits;
 
@@ -43,6 +43,7 @@
 
 #include "arch/x86/ldstflags.hh"
 #include "base/compiler.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/str.hh"
 #include "cpu/testers/rubytest/RubyTester.hh"
@@ -67,8 +68,149 @@ namespace gem5
 namespace ruby
 {
 
+SequencerRequestTable::SequencerRequestTable(int capacity)
+    : m_num_keys(0), m_free(nullptr)
+{
+    // Keep the table at most half full, as there are never more keys
+    // than requests
+    m_slot_bits = std::max(3, ceilLog2(2 * capacity));
+    m_slots.resize(1 << m_slot_bits);
+
+    for (int i = 0; i < capacity; i++) {
+        m_pool.emplace_back();
+        m_pool.back().next = m_free;
+        m_free = &m_pool.back();
+    }
+}
+
+int
+SequencerRequestTable::findSlot(uint64_t key) const
+{
+    int mask = m_slots.size() - 1;
+    for (int idx = homeSlot(key); m_slots[idx].head; idx = (idx + 1) & mask) {
+        if (m_slots[idx].key == key)
+            return idx;
+    }
+    return -1;
+}
+
+int
+SequencerRequestTable::push(uint64_t key, const SequencerRequest &request)
+{
+    int idx = findSlot(key);
+    if (idx < 0) {
+        if (2 * (m_num_keys + 1) > (int)m_slots.size())
+            grow();
+        int mask = m_slots.size() - 1;
+        for (idx = homeSlot(key); m_slots[idx].head; idx = (idx + 1) & mask)
+            ;
+        m_slots[idx].key = key;
+        m_num_keys++;
+    }
+
+    if (!m_free) {
+        m_pool.emplace_back();
+        m_free = &m_pool.back();
+    }
+    Node *node = m_free;
+    m_free = node->next;
+    node->request = request;
+    node->next = nullptr;
+
+    Slot &slot = m_slots[idx];
+    if (slot.tail)
+        slot.tail->next = node;
+    else
+        slot.head = node;
+    slot.tail = node;
+    return ++slot.length;
+}
+
+SequencerRequest *
+SequencerRequestTable::front(uint64_t key)
+{
+    int idx = findSlot(key);
+    return idx < 0 ? nullptr : &m_slots[idx].head->request;
+}
+
+void
+SequencerRequestTable::popFront(uint64_t key)
+{
+    int idx = findSlot(key);
+    assert(idx >= 0);
+
+    Slot &slot = m_slots[idx];
+    Node *node = slot.head;
+    slot.head = node->next;
+    node->next = m_free;
+    m_free = node;
+
+    if (--slot.length == 0)
+        eraseSlot(idx);
+}
+
+int
+SequencerRequestTable::queueLength(uint64_t key) const
+{
+    int idx = findSlot(key);
+    return idx < 0 ? 0 : m_slots[idx].length;
+}
+
+void
+SequencerRequestTable::eraseSlot(int idx)
+{
+    // Shift back the keys probed past the freed slot, so that every key
+    // stays reachable from its home slot without tombstones
+    int mask = m_slots.size() - 1;
+    for (int next = (idx + 1) & mask; m_slots[next].head;
+         next = (next + 1) & mask) {
+        int home = homeSlot(m_slots[next].key);
+        if (((next - home) & mask) >= ((next - idx) & mask)) {
+            m_slots[idx] = m_slots[next];
+            idx = next;
+        }
+    }
+    m_slots[idx] = Slot();
+    m_num_keys--;
+}
+
+void
+SequencerRequestTable::grow()
+{
+    std::vector<Slot> old_slots(2 * m_slots.size());
+    old_slots.swap(m_slots);
+    m_slot_bits++;
+
+    int mask = m_slots.size() - 1;
+    for (const auto &slot : old_slots) {
+        if (!slot.head)
+            continue;
+        int idx = homeSlot(slot.key);
+        while (m_slots[idx].head)
+            idx = (idx + 1) & mask;
+        m_slots[idx] = slot;
+    }
+}
+
+void
+SequencerRequestTable::print(std::ostream &out) const
+{
+    for (const auto &slot : m_slots) {
+        if (!slot.head)
+            continue;
+        out << "[ " << slot.key << " =";
+        for (const Node *node = slot.head; node; node = node->next) {
+            out << " "
+                << RubyRequestType_to_string(node->request.m_second_type);
+        }
+    }
+    out << " ]";
+}
+
 Sequencer::Sequencer(const Params &p)
-    : RubyPort(p), m_IncompleteTimes(MachineType_NUM),
+    : RubyPort(p), m_RequestTable(p.max_outstanding_requests),
+      m_UnaddressedRequestTable(UnaddressedCapacity),
+      m_IncompleteTimes(MachineType_NUM),
       deadlockCheckEvent([this]{ wakeup(); }, "Sequencer deadlock check")
 {
     m_outstanding_count = 0;
@@ -232,21 +374,19 @@ Sequencer::wakeup()
     // Check across all outstanding requests
     [[maybe_unused]] int total_outstanding = 0;
 
-    for (const auto &table_entry : m_RequestTable) {
-        for (const auto &seq_req : table_entry.second) {
-            if (current_time - seq_req.issue_time < m_deadlock_threshold)
-                continue;
-
-            panic("Possible Deadlock detected. Aborting!\n version: %d "
-                  "request.paddr: 0x%x m_readRequestTable: %d current time: "
-                  "%u issue_time: %d difference: %d\n", m_version,
-                  seq_req.pkt->getAddr(), table_entry.second.size(),
-                  current_time * clockPeriod(), seq_req.issue_time
-                  * clockPeriod(), (current_time * clockPeriod())
-                  - (seq_req.issue_time * clockPeriod()));
-        }
-        total_outstanding += table_entry.second.size();
-    }
+    m_RequestTable.forEach([&](Addr line, const SequencerRequest &seq_req) {
+        total_outstanding++;
+        if (current_time - seq_req.issue_time < m_deadlock_threshold)
+            return;
+
+        panic("Possible Deadlock detected. Aborting!\n version: %d "
+              "request.paddr: 0x%x m_readRequestTable: %d current time: "
+              "%u issue_time: %d difference: %d\n", m_version,
+              seq_req.pkt->getAddr(), m_RequestTable.queueLength(line),
+              current_time * clockPeriod(), seq_req.issue_time
+              * clockPeriod(), (current_time * clockPeriod())
+              - (seq_req.issue_time * clockPeriod()));
+    });
 
     assert(m_outstanding_count == total_outstanding);
 
@@ -261,12 +401,10 @@ Sequencer::functionalWrite(Packet *func_pkt)
 {
     int num_written = RubyPort::functionalWrite(func_pkt);
 
-    for (const auto &table_entry : m_RequestTable) {
-        for (const auto& seq_req : table_entry.second) {
-            if (seq_req.functionalWrite(func_pkt))
-                ++num_written;
-        }
-    }
+    m_RequestTable.forEach([&](Addr line, const SequencerRequest &seq_req) {
+        if (seq_req.functionalWrite(func_pkt))
+            ++num_written;
+    });
 
     return num_written;
 }
@@ -324,15 +462,14 @@ Sequencer::insertRequest(PacketPtr pkt, RubyRequestType primary_type,
             {
                 incrementUnaddressedTransactionCnt();
 
-                // returns pair<inserted element, was inserted>
-                [[maybe_unused]] auto insert_data = \
-                    m_UnaddressedRequestTable.emplace(
+                // returns the number of requests with this ID
+                [[maybe_unused]] int num_queued = \
+                    m_UnaddressedRequestTable.push(
                         getCurrentUnaddressedTransactionID(),
                         SequencerRequest(
                             pkt, primary_type, secondary_type, curCycle()));
 
-                // if insert_data.second is false, wasn't inserted
-                assert(insert_data.second &&
+                assert(num_queued == 1 &&
                        "Another TLBI request with the same ID exists");
 
                 DPRINTF(RubySequencer, "Inserting TLBI request %016x\n",
@@ -350,13 +487,11 @@ Sequencer::insertRequest(PacketPtr pkt, RubyRequestType primary_type,
 
     Addr line_addr = makeLineAddress(pkt->getAddr());
     // Check if there is any outstanding request for the same cache line.
-    auto &seq_req_list = m_RequestTable[line_addr];
-    // Create a default entry
-    seq_req_list.emplace_back(pkt, primary_type,
-        secondary_type, curCycle());
+    int num_queued = m_RequestTable.push(line_addr,
+        SequencerRequest(pkt, primary_type, secondary_type, curCycle()));
     m_outstanding_count++;
 
-    if (seq_req_list.size() > 1) {
+    if (num_queued > 1) {
         return RequestStatus_Aliased;
     }
 
@@ -457,15 +592,14 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
     // to this cache line when response for the write comes back
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.contains(address));
 
     // Perform hitCallback on every cpu request made to this cache block while
     // ruby request was outstanding. Since only 1 ruby request was made,
     // profile the ruby latency once.
     bool ruby_request = true;
-    while (!seq_req_list.empty()) {
-        SequencerRequest &seq_req = seq_req_list.front();
+    while (SequencerRequest *front = m_RequestTable.front(address)) {
+        SequencerRequest &seq_req = *front;
 
         if (noCoales && !ruby_request) {
             // Do not process follow-up requests
@@ -533,12 +667,7 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
                         initialRequestTime, forwardRequestTime,
                         firstResponseTime, !ruby_request);
         }
-        seq_req_list.pop_front();
-    }
-
-    // free all outstanding requests corresponding to this address
-    if (seq_req_list.empty()) {
-        m_RequestTable.erase(address);
+        m_RequestTable.popFront(address);
     }
 }
 
@@ -554,15 +683,14 @@ Sequencer::readCallback(Addr address, DataBlock& data,
     // or end of the corresponding list.
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.contains(address));
 
     // Perform hitCallback on every cpu request made to this cache block while
     // ruby request was outstanding. Since only 1 ruby request was made,
     // profile the ruby latency once.
     bool ruby_request = true;
-    while (!seq_req_list.empty()) {
-        SequencerRequest &seq_req = seq_req_list.front();
+    while (SequencerRequest *front = m_RequestTable.front(address)) {
+        SequencerRequest &seq_req = *front;
         if (ruby_request) {
             assert((seq_req.m_type == RubyRequestType_LD) ||
                    (seq_req.m_type == RubyRequestType_Load_Linked) ||
@@ -585,12 +713,7 @@ Sequencer::readCallback(Addr address, DataBlock& data,
                     initialRequestTime, forwardRequestTime,
                     firstResponseTime, !ruby_request);
         ruby_request = false;
-        seq_req_list.pop_front();
-    }
-
-    // free all outstanding requests corresponding to this address
-    if (seq_req_list.empty()) {
-        m_RequestTable.erase(address);
+        m_RequestTable.popFront(address);
     }
 }
 
@@ -721,12 +844,11 @@ Sequencer::unaddressedCallback(Addr unaddressedReqId,
         // These signal that a TLBI operation that this core initiated
         // of the respective type (TLBI or Sync) has finished.
 
-        assert(m_UnaddressedRequestTable.find(unaddressedReqId)
-               != m_UnaddressedRequestTable.end());
+        assert(m_UnaddressedRequestTable.contains(unaddressedReqId));
 
         {
             SequencerRequest &seq_req =
-                m_UnaddressedRequestTable.at(unaddressedReqId);
+                *m_UnaddressedRequestTable.front(unaddressedReqId);
             assert(seq_req.m_type == reqType);
 
             PacketPtr pkt = seq_req.pkt;
@@ -735,7 +857,7 @@ Sequencer::unaddressedCallback(Addr unaddressedReqId,
             testDrainComplete();
         }
 
-        m_UnaddressedRequestTable.erase(unaddressedReqId);
+        m_UnaddressedRequestTable.popFront(unaddressedReqId);
         break;
       }
       default:
@@ -936,21 +1058,6 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
     m_mandatory_q_ptr->enqueue(msg, clockEdge(), latency);
 }
 
-template <class KEY, class VALUE>
-std::ostream &
-operator<<(std::ostream &out, const std::unordered_map<KEY, VALUE> &map)
-{
-    for (const auto &table_entry : map) {
-        out << "[ " << table_entry.first << " =";
-        for (const auto &seq_req : table_entry.second) {
-            out << " " << RubyRequestType_to_string(seq_req.m_second_type);
-        }
-    }
-    out << " ]";
-
-    return out;
-}
-
 void
 Sequencer::print(std::ostream& out) const
 {
@@ -41,9 +41,9 @@
 #ifndef __MEM_RUBY_SYSTEM_SEQUENCER_HH__
 #define __MEM_RUBY_SYSTEM_SEQUENCER_HH__
 
+#include <deque>
 #include <iostream>
-#include <list>
-#include <unordered_map>
+#include <vector>
 
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/protocol/MachineType.hh"
@@ -83,6 +83,99 @@ struct SequencerRequest
 
 std::ostream& operator<<(std::ostream& out, const SequencerRequest& obj);
 
+/**
+ * Outstanding sequencer requests, queued in arrival order per key (the
+ * line address, or the id of an unaddressed request).
+ *
+ * The queues are kept in an open-addressed table with linear probing and
+ * the requests in a pool of nodes recycled through a free list. Both are
+ * sized for the expected number of outstanding requests when the table
+ * is built, so inserting and retiring requests does not allocate; they
+ * only grow if that number is exceeded. A request does not move while it
+ * is queued, so the one returned by front() stays valid across pushes
+ * until it is popped.
+ */
+class SequencerRequestTable
+{
+  public:
+    SequencerRequestTable(int capacity);
+
+    // Queue a request after the others for the key; returns the number
+    // of requests queued for the key, including this one
+    int push(uint64_t key, const SequencerRequest &request);
+
+    // Oldest request queued for the key, or nullptr if there is none
+    SequencerRequest *front(uint64_t key);
+
+    // Retire the oldest request of the key, dropping the key once its
+    // queue is empty
+    void popFront(uint64_t key);
+
+    bool contains(uint64_t key) const { return findSlot(key) >= 0; }
+    int queueLength(uint64_t key) const;
+    bool empty() const { return m_num_keys == 0; }
+
+    // Call f(key, request) on every request, in order within each key
+    template <typename F>
+    void
+    forEach(F f) const
+    {
+        for (const auto &slot : m_slots) {
+            for (const Node *node = slot.head; node; node = node->next)
+                f(slot.key, node->request);
+        }
+    }
+
+    void print(std::ostream &out) const;
+
+  private:
+    struct Node
+    {
+        Node()
+          : request(nullptr, RubyRequestType_NULL, RubyRequestType_NULL,
+                    Cycles(0)),
+            next(nullptr)
+        {}
+
+        SequencerRequest request;
+        Node *next;
+    };
+
+    // A slot without a head is free
+    struct Slot
+    {
+        uint64_t key = 0;
+        Node *head = nullptr;
+        Node *tail = nullptr;
+        int length = 0;
+    };
+
+    int
+    homeSlot(uint64_t key) const
+    {
+        return (key * 0x9e3779b97f4a7c15ULL) >> (64 - m_slot_bits);
+    }
+
+    int findSlot(uint64_t key) const;
+    void eraseSlot(int idx);
+    void grow();
+
+    std::vector<Slot> m_slots;
+    int m_slot_bits;
+    int m_num_keys;
+
+    // A deque, so that growing the pool does not move queued requests
+    std::deque<Node> m_pool;
+    Node *m_free;
+};
+
+inline std::ostream&
+operator<<(std::ostream& out, const SequencerRequestTable& obj)
+{
+    obj.print(out);
+    return out;
+}
+
 class Sequencer : public RubyPort
 {
   public:
@@ -221,10 +314,12 @@ class Sequencer : public RubyPort
 
   protected:
     // RequestTable contains both read and write requests, handles aliasing
-    std::unordered_map<Addr, std::list<SequencerRequest>> m_RequestTable;
+    SequencerRequestTable m_RequestTable;
     // UnadressedRequestTable contains "unaddressed" requests,
     // guaranteed not to alias each other
-    std::unordered_map<uint64_t, SequencerRequest> m_UnaddressedRequestTable;
+    SequencerRequestTable m_UnaddressedRequestTable;
+    // TLBI requests in flight that the unaddressed table is sized for
+    static const int UnaddressedCapacity = 4;
 
     Cycles m_deadlock_threshold;
 
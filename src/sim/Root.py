@@ -31,6 +31,10 @@ from m5.params import *
 from m5.util import fatal
 
 
+class EventQueueBackend(Enum):
+    vals = ["linked_list", "calendar"]
+
+
 class Root(SimObject):
 
     _the_instance = None
@@ -68,6 +72,12 @@ class Root(SimObject):
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    # Structure of the event queues. Both service the events in the same
+    # order, the calendar queue is faster with many distinct event times.
+    event_queue_backend = Param.EventQueueBackend(
+        "linked_list", "structure keeping the pending events in order"
+    )
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
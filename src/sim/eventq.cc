@@ -30,6 +30,7 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <mutex>
@@ -134,9 +135,240 @@ Event::releaseImpl()
         delete this;
 }
 
+CalendarQueue::CalendarQueue()
+    : buckets(MinBuckets, nullptr),
+      // Recomputed from the pending times at the first resize
+      width(1000), numBins(0), first(nullptr), firstBucket(0),
+      sliceStart(0)
+{
+}
+
+void
+CalendarQueue::setFirst(Event *bin)
+{
+    first = bin;
+    if (bin) {
+        firstBucket = bucketOf(bin->when());
+        sliceStart = bin->when() - bin->when() % width;
+    }
+}
+
+void
+CalendarQueue::findFirst()
+{
+    if (numBins == 0) {
+        first = nullptr;
+        return;
+    }
+
+    // Scan one year of slices from the one of the previous first bin.
+    // Buckets are sorted, so the first bin of a bucket in its slice is
+    // the earliest one.
+    size_t bucket = firstBucket;
+    Tick start = sliceStart;
+    for (size_t n = 0; n < buckets.size(); n++) {
+        Event *bin = buckets[bucket];
+        if (bin && bin->when() - start < width) {
+            first = bin;
+            firstBucket = bucket;
+            sliceStart = start;
+            return;
+        }
+        if (start > MaxTick - width)
+            break;
+        start += width;
+        bucket = (bucket + 1) & (buckets.size() - 1);
+    }
+
+    // Nothing in the coming year, look for the earliest bin directly
+    Event *earliest = nullptr;
+    for (Event *bin : buckets) {
+        if (bin && (!earliest || *bin < *earliest))
+            earliest = bin;
+    }
+    setFirst(earliest);
+}
+
+void
+CalendarQueue::insertBin(Event *bin)
+{
+    Event **link = &buckets[bucketOf(bin->when())];
+    while (*link && **link < *bin)
+        link = &(*link)->nextBin;
+    assert(!*link || **link != *bin);
+    bin->nextBin = *link;
+    *link = bin;
+}
+
+void
+CalendarQueue::resize(size_t num_buckets)
+{
+    std::vector<Event *> all;
+    all.reserve(numBins);
+    for (Event *bin : buckets) {
+        for (; bin; bin = bin->nextBin)
+            all.push_back(bin);
+    }
+
+    // Set the width to three times the average distance between the
+    // earliest pending times, ignoring the outliers
+    const size_t samples = std::min<size_t>(all.size(), 32);
+    std::partial_sort(all.begin(), all.begin() + samples, all.end(),
+                      [](Event *l, Event *r) { return *l < *r; });
+    Tick total = 0;
+    size_t gaps = 0;
+    for (size_t i = 1; i < samples; i++) {
+        total += all[i]->when() - all[i - 1]->when();
+        gaps++;
+    }
+    if (total > 0) {
+        const Tick average = total / gaps;
+        Tick kept_total = 0;
+        size_t kept = 0;
+        for (size_t i = 1; i < samples; i++) {
+            Tick gap = all[i]->when() - all[i - 1]->when();
+            if (gap <= 2 * average) {
+                kept_total += gap;
+                kept++;
+            }
+        }
+        const Tick kept_average = std::max<Tick>(kept_total / kept, 1);
+        width = std::min(kept_average, MaxTick / 3) * 3;
+    }
+
+    buckets.assign(num_buckets, nullptr);
+    for (Event *bin : all)
+        insertBin(bin);
+    setFirst(all.empty() ? nullptr : all[0]);
+}
+
+Event *
+CalendarQueue::insert(Event *event)
+{
+    // Find the bin of the event in its bucket, or where to insert it
+    Event **link = &buckets[bucketOf(event->when())];
+    while (*link && **link < *event)
+        link = &(*link)->nextBin;
+
+    const bool new_bin = !*link || *event < **link;
+    *link = Event::insertBefore(event, *link);
+
+    // Either before the first bin, or on top of it
+    if (!first || *event <= *first)
+        setFirst(event);
+
+    if (new_bin && ++numBins > 2 * buckets.size())
+        resize(2 * buckets.size());
+    return first;
+}
+
+Event *
+CalendarQueue::remove(Event *event)
+{
+    Event **link = &buckets[bucketOf(event->when())];
+    while (*link && **link < *event)
+        link = &(*link)->nextBin;
+
+    if (!*link || **link != *event)
+        panic("event not found!");
+
+    Event *top = *link;
+    Event *next_bin = top->nextBin;
+    *link = Event::removeItem(event, top);
+
+    if (*link != next_bin) {
+        // The bin is still there, possibly with a new top event
+        if (top == first)
+            first = *link;
+    } else {
+        numBins--;
+        if (numBins < buckets.size() / 2 && buckets.size() > MinBuckets)
+            resize(buckets.size() / 2);
+        else if (top == first)
+            findFirst();
+    }
+    return first;
+}
+
+Event *
+CalendarQueue::pop()
+{
+    Event *event = first;
+    Event *next = event->nextInBin;
+
+    // The first bin is the first one of its bucket
+    assert(buckets[firstBucket] == event);
+    if (next) {
+        next->nextBin = event->nextBin;
+        buckets[firstBucket] = next;
+        first = next;
+    } else {
+        buckets[firstBucket] = event->nextBin;
+        numBins--;
+        if (numBins < buckets.size() / 2 && buckets.size() > MinBuckets)
+            resize(buckets.size() / 2);
+        else
+            findFirst();
+    }
+    return first;
+}
+
+std::vector<Event *>
+CalendarQueue::bins() const
+{
+    std::vector<Event *> all;
+    all.reserve(numBins);
+    for (Event *bin : buckets) {
+        for (; bin; bin = bin->nextBin)
+            all.push_back(bin);
+    }
+    std::sort(all.begin(), all.end(),
+              [](Event *l, Event *r) { return *l < *r; });
+    return all;
+}
+
+Event *
+CalendarQueue::extract()
+{
+    std::vector<Event *> all = bins();
+    for (size_t i = 0; i < all.size(); i++)
+        all[i]->nextBin = i + 1 < all.size() ? all[i + 1] : nullptr;
+
+    buckets.assign(MinBuckets, nullptr);
+    numBins = 0;
+    first = nullptr;
+    return all.empty() ? nullptr : all[0];
+}
+
+Event *
+CalendarQueue::insertBins(Event *bins)
+{
+    while (bins) {
+        Event *next = bins->nextBin;
+        insertBin(bins);
+        numBins++;
+        bins = next;
+    }
+
+    // Size the calendar for the new bins, which also finds the first one
+    size_t num_buckets = MinBuckets;
+    while (2 * num_buckets < numBins)
+        num_buckets *= 2;
+    resize(num_buckets);
+    return first;
+}
+
+EventQueue::Backend EventQueue::defaultBackend =
+    EventQueue::Backend::LinkedList;
+
 void
 EventQueue::insert(Event *event)
 {
+    if (backend == Backend::Calendar) {
+        head = calendar.insert(event);
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -196,6 +428,11 @@ EventQueue::remove(Event *event)
 
     assert(event->queue == this);
 
+    if (backend == Backend::Calendar) {
+        head = calendar.remove(event);
+        return;
+    }
+
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
@@ -228,7 +465,9 @@ EventQueue::serviceOne()
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (backend == Backend::Calendar) {
+        head = calendar.pop();
+    } else if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -321,15 +560,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
+        for (Event *nextBin : bins()) {
             Event *nextInBin = nextBin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -344,8 +580,7 @@ EventQueue::debugVerify() const
     Tick time = 0;
     short priority = 0;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    for (Event *nextBin : bins()) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -371,21 +606,45 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
 }
 
+std::vector<Event *>
+EventQueue::bins() const
+{
+    if (backend == Backend::Calendar)
+        return calendar.bins();
+
+    std::vector<Event *> all;
+    for (Event *bin = head; bin; bin = bin->nextBin)
+        all.push_back(bin);
+    return all;
+}
+
 Event*
 EventQueue::replaceHead(Event* s)
 {
     Event* t = head;
-    head = s;
+    if (backend == Backend::Calendar) {
+        // Hand out the bins as a list, as the linked list backend does
+        t = calendar.extract();
+        head = calendar.insertBins(s);
+    } else {
+        head = s;
+    }
     return t;
 }
 
+void
+EventQueue::setBackend(Backend new_backend)
+{
+    Event *events = replaceHead(nullptr);
+    backend = new_backend;
+    replaceHead(events);
+}
+
 void
 dumpMainQueue()
 {
@@ -442,7 +701,7 @@ Event::dump() const
 }
 
 EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), head(NULL), _curTick(0), backend(defaultBackend)
 {
 }
 
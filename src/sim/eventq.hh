@@ -43,6 +43,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
@@ -254,6 +255,7 @@ class EventBase
 class Event : public EventBase, public Serializable
 {
     friend class EventQueue;
+    friend class CalendarQueue;
 
   private:
     // The event queue is now a linked list of linked lists.  The
@@ -574,6 +576,73 @@ operator!=(const Event &l, const Event &r)
     return l.when() != r.when() || l.priority() != r.priority();
 }
 
+/**
+ * Calendar queue (R. Brown, CACM 1988) of the bins of events of an
+ * EventQueue. The bins are hashed by time into an array of buckets, each
+ * one covering a slice of 'width' ticks every 'year' of buckets.size()
+ * slices, and kept in time order in their bucket (linked by nextBin).
+ * Finding the next bin scans the buckets from the slice of the current
+ * one, which takes O(1) amortized as long as the width is close to the
+ * distance between pending times; the width and the number of buckets
+ * are recomputed whenever the number of bins doubles or halves.
+ *
+ * The bins and their LIFO lists are the ones of the linked list of bins
+ * of the EventQueue, so the events are serviced in exactly the same
+ * order with either structure.
+ */
+class CalendarQueue
+{
+  public:
+    CalendarQueue();
+
+    //! Insert an event at the top of its bin
+    //! @return The first bin
+    Event *insert(Event *event);
+
+    //! Remove an event from its bin
+    //! @return The first bin
+    Event *remove(Event *event);
+
+    //! Remove the top event of the first bin
+    //! @return The first bin
+    Event *pop();
+
+    //! Remove all the bins
+    //! @return The bins, in time order, linked by nextBin
+    Event *extract();
+
+    //! Insert the bins of a list linked by nextBin
+    //! @return The first bin
+    Event *insertBins(Event *bins);
+
+    //! @return The top event of every bin, in time order
+    std::vector<Event *> bins() const;
+
+  private:
+    static const size_t MinBuckets = 16;
+
+    std::vector<Event *> buckets;
+    Tick width;
+    size_t numBins;
+
+    //! First bin, its bucket and the start of its slice. No bin is
+    //! older than that slice.
+    Event *first;
+    size_t firstBucket;
+    Tick sliceStart;
+
+    size_t
+    bucketOf(Tick when) const
+    {
+        return (when / width) & (buckets.size() - 1);
+    }
+
+    void setFirst(Event *bin);
+    void findFirst();
+    void insertBin(Event *bin);
+    void resize(size_t num_buckets);
+};
+
 /**
  * Queue of events sorted in time order
  *
@@ -617,10 +686,26 @@ class EventQueue
   private:
     friend void curEventQueue(EventQueue *);
 
+  public:
+    /**
+     * Structure keeping the bins of events in order: a linked list,
+     * with inserts linear in the number of distinct pending times, or a
+     * calendar queue, O(1) amortized. Both service events in the same
+     * order.
+     */
+    enum class Backend { LinkedList, Calendar };
+
+    //! Backend of the event queues created from now on
+    static Backend defaultBackend;
+
+  private:
     std::string objName;
     Event *head;
     Tick _curTick;
 
+    Backend backend;
+    CalendarQueue calendar;
+
     //! Mutex to protect async queue.
     UncontendedMutex async_queue_mutex;
 
@@ -649,6 +734,9 @@ class EventQueue
      */
     UncontendedMutex service_mutex;
 
+    //! Top event of every bin, in time order
+    std::vector<Event *> bins() const;
+
     //! Insert / remove event from the queue. Should only be called
     //! by thread operating this queue.
     void insert(Event *event);
@@ -932,6 +1020,13 @@ class EventQueue
      */
     Event* replaceHead(Event* s);
 
+    /**
+     * Move the pending events to another backend. The order in which
+     * they are serviced is unchanged.
+     */
+    void setBackend(Backend new_backend);
+    Backend getBackend() const { return backend; }
+
     /**@{*/
     /**
      * Provide an interface for locking/unlocking the event queue.
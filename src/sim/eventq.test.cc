@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+typedef std::vector<std::pair<Tick, int>> ServiceLog;
+
+/** Event logging its id and the tick at which it is serviced. */
+class LogEvent : public Event
+{
+  public:
+    LogEvent(int id, Priority prio, ServiceLog &log)
+        : Event(prio), id(id), log(log)
+    {}
+
+    void process() override { log.emplace_back(when(), id); }
+
+    const int id;
+
+  private:
+    ServiceLog &log;
+};
+
+/** Events of a test, and the order in which they were serviced. */
+class EventLog
+{
+  public:
+    LogEvent *
+    create(Event::Priority prio=Event::Default_Pri)
+    {
+        events.emplace_back(new LogEvent(events.size(), prio, serviced));
+        return events.back().get();
+    }
+
+    ~EventLog()
+    {
+        for (auto &event : events) {
+            if (event->scheduled())
+                curEventQueue()->deschedule(event.get());
+        }
+    }
+
+    std::vector<std::unique_ptr<LogEvent>> events;
+    ServiceLog serviced;
+};
+
+/**
+ * Pseudo-random schedules, deschedules and reschedules of the events of
+ * a log, with times in (now, now + spread]. Only depends on the state
+ * of the events, so both backends must do the same operations.
+ */
+void
+shuffleEvents(EventQueue &eq, EventLog &log, uint64_t &seed, int ops,
+              Tick spread)
+{
+    static const Event::Priority prios[] = {
+        Event::Minimum_Pri, Event::Default_Pri, Event::CPU_Tick_Pri
+    };
+
+    for (int i = 0; i < ops; i++) {
+        // xorshift64
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        Tick when = eq.getCurTick() + 1 + seed % spread;
+        if (seed % 8 == 0 || log.events.empty()) {
+            eq.schedule(log.create(prios[(seed >> 8) % 3]), when);
+            continue;
+        }
+        LogEvent *event = log.events[(seed >> 16) % log.events.size()].get();
+        if (!event->scheduled())
+            eq.schedule(event, when);
+        else if (seed % 8 < 4)
+            eq.deschedule(event);
+        else
+            eq.reschedule(event, when);
+    }
+}
+
+void
+serviceEvents(EventQueue &eq, int num)
+{
+    for (int i = 0; i < num && !eq.empty(); i++) {
+        eq.setCurTick(eq.nextTick());
+        eq.serviceOne();
+    }
+}
+
+/**
+ * Run a test on a new event queue with the given backend, then service
+ * the events left.
+ * @return The order in which the events were serviced.
+ */
+template <typename Test>
+ServiceLog
+runQueue(EventQueue::Backend backend, Test test)
+{
+    EventQueue eq("test");
+    eq.setBackend(backend);
+    EventQueue *old_eq = curEventQueue();
+    curEventQueue(&eq);
+
+    ServiceLog serviced;
+    {
+        EventLog log;
+        test(eq, log);
+        EXPECT_TRUE(eq.debugVerify());
+        serviceEvents(eq, std::numeric_limits<int>::max());
+        serviced = log.serviced;
+    }
+
+    curEventQueue(old_eq);
+    return serviced;
+}
+
+} // anonymous namespace
+
+/** Same-tick events are serviced by priority, then LIFO. */
+TEST(EventQueueTest, SameTickOrder)
+{
+    auto test = [](EventQueue &eq, EventLog &log) {
+        eq.schedule(log.create(Event::Default_Pri), 100);
+        eq.schedule(log.create(Event::CPU_Tick_Pri), 100);
+        eq.schedule(log.create(Event::Default_Pri), 100);
+        eq.schedule(log.create(Event::Minimum_Pri), 100);
+        eq.schedule(log.create(Event::Default_Pri), 50);
+        eq.schedule(log.create(Event::Default_Pri), 100);
+    };
+    const ServiceLog expected = {
+        {50, 4}, {100, 3}, {100, 5}, {100, 2}, {100, 0}, {100, 1}
+    };
+
+    ServiceLog list = runQueue(EventQueue::Backend::LinkedList, test);
+    ServiceLog calendar = runQueue(EventQueue::Backend::Calendar, test);
+    EXPECT_EQ(list, expected);
+    EXPECT_EQ(calendar, expected);
+}
+
+/**
+ * Deschedule the top, the bottom and the only event of a bin, events
+ * of the first bin, and reschedule events to other bins.
+ */
+TEST(EventQueueTest, Deschedule)
+{
+    auto test = [](EventQueue &eq, EventLog &log) {
+        for (int i = 0; i < 12; i++)
+            eq.schedule(log.create(), 10 * (1 + i % 4));
+        eq.schedule(log.create(), 1000);
+
+        eq.deschedule(log.events[8].get());   // top of the bin at 10
+        eq.deschedule(log.events[0].get());   // bottom of the bin at 10
+        eq.deschedule(log.events[12].get());  // only event at 1000
+        eq.deschedule(log.events[9].get());   // top of the bin at 20
+        eq.reschedule(log.events[5].get(), 10);
+        eq.reschedule(log.events[3].get(), 500);
+        EXPECT_TRUE(eq.debugVerify());
+
+        serviceEvents(eq, 2);
+        eq.deschedule(log.events[1].get());   // bottom of the first bin
+        eq.deschedule(log.events[7].get());
+        eq.deschedule(log.events[11].get());  // empties the bin at 40
+    };
+    const ServiceLog expected = {
+        {10, 5}, {10, 4}, {30, 10}, {30, 6}, {30, 2}, {500, 3}
+    };
+
+    ServiceLog list = runQueue(EventQueue::Backend::LinkedList, test);
+    ServiceLog calendar = runQueue(EventQueue::Backend::Calendar, test);
+    EXPECT_EQ(list, expected);
+    EXPECT_EQ(calendar, expected);
+
+    // The same on a random mix of operations
+    auto random_test = [](EventQueue &eq, EventLog &log) {
+        uint64_t seed = 1;
+        for (int i = 0; i < 50; i++) {
+            shuffleEvents(eq, log, seed, 40, 200);
+            serviceEvents(eq, 20);
+        }
+    };
+    list = runQueue(EventQueue::Backend::LinkedList, random_test);
+    calendar = runQueue(EventQueue::Backend::Calendar, random_test);
+    EXPECT_GT(list.size(), 100);
+    EXPECT_EQ(list, calendar);
+}
+
+/** Switching the backend of a queue keeps its pending events. */
+TEST(EventQueueTest, SetBackend)
+{
+    auto test = [](bool switch_backend) {
+        return [switch_backend](EventQueue &eq, EventLog &log) {
+            uint64_t seed = 2;
+            for (int i = 0; i < 20; i++) {
+                shuffleEvents(eq, log, seed, 100, 1000);
+                serviceEvents(eq, 50);
+                if (switch_backend) {
+                    eq.setBackend(i % 2 ?
+                                  EventQueue::Backend::LinkedList :
+                                  EventQueue::Backend::Calendar);
+                    EXPECT_TRUE(eq.debugVerify());
+                }
+            }
+        };
+    };
+
+    ServiceLog list = runQueue(EventQueue::Backend::LinkedList,
+                               test(false));
+    ServiceLog switched = runQueue(EventQueue::Backend::LinkedList,
+                                   test(true));
+    EXPECT_GT(list.size(), 500);
+    EXPECT_EQ(list, switched);
+}
+
+/**
+ * Grow and shrink the queue, with pending times close together and far
+ * apart, so that the calendar changes its number of buckets and their
+ * width several times.
+ */
+TEST(EventQueueTest, Resize)
+{
+    auto test = [](EventQueue &eq, EventLog &log) {
+        uint64_t seed = 3;
+        static const Tick spreads[] = { 10, 100000, 3, 5000000, 1000 };
+        for (Tick spread : spreads) {
+            shuffleEvents(eq, log, seed, 3000, spread);
+            EXPECT_TRUE(eq.debugVerify());
+            serviceEvents(eq, 2500);
+            EXPECT_TRUE(eq.debugVerify());
+        }
+        // Times far in the future, beyond a year of buckets
+        for (int i = 0; i < 100; i++) {
+            eq.schedule(log.create(),
+                        eq.getCurTick() + (1 + i) * (MaxTick / 256));
+        }
+    };
+
+    ServiceLog list = runQueue(EventQueue::Backend::LinkedList, test);
+    ServiceLog calendar = runQueue(EventQueue::Backend::Calendar, test);
+    EXPECT_GT(list.size(), 4000);
+    EXPECT_EQ(list, calendar);
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 The AI_X-Lab Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Microbenchmark of the event queue backends. Each backend services the
+ * same events: a set of clocked objects with self-rescheduling events at
+ * multiples of various clock periods, rescheduling each other now and
+ * then. The order of the serviced events, summarized by a hash, must be
+ * the same with both backends.
+ *
+ * Usage: eventqtime [objects [events]]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class BenchEvent : public Event
+{
+  public:
+    BenchEvent(int id, Tick period, Priority prio, uint64_t seed,
+               std::vector<std::unique_ptr<BenchEvent>> &objects,
+               uint64_t &hash)
+        : Event(prio), id(id), period(period), rng(seed),
+          objects(objects), hash(hash)
+    {}
+
+    void
+    process() override
+    {
+        EventQueue *eq = curEventQueue();
+        const Tick now = eq->getCurTick();
+        hash = (hash ^ (now * 31 + id)) * 0x100000001b3ULL;
+
+        // Mostly short delays, sometimes a far one
+        uint64_t r = next();
+        Tick delay = period * (1 + r % 4);
+        if (r % 64 == 0)
+            delay = period * (100 + r % 1000);
+        eq->schedule(this, now + delay);
+
+        // Every so often, move the next wakeup of another object
+        if (r % 16 == 1) {
+            BenchEvent *other = objects[next() % objects.size()].get();
+            if (other != this)
+                eq->reschedule(other, now + other->period, true);
+        }
+    }
+
+    const char *description() const override { return "bench"; }
+
+    const int id;
+    const Tick period;
+
+  private:
+    uint64_t
+    next()
+    {
+        // xorshift64
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return rng;
+    }
+
+    uint64_t rng;
+    std::vector<std::unique_ptr<BenchEvent>> &objects;
+    uint64_t &hash;
+};
+
+struct Result
+{
+    double seconds;
+    uint64_t hash;
+};
+
+Result
+run(EventQueue::Backend backend, int num_objects, uint64_t num_events)
+{
+    EventQueue eq("bench");
+    eq.setBackend(backend);
+    curEventQueue(&eq);
+
+    // Clock periods of a few clock domains, in ticks
+    static const Tick periods[] = { 250, 333, 500, 625, 1000, 1250 };
+    static const Event::Priority prios[] = {
+        Event::Default_Pri, Event::CPU_Tick_Pri, Event::Delayed_Writeback_Pri
+    };
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    std::vector<std::unique_ptr<BenchEvent>> objects;
+    for (int i = 0; i < num_objects; i++) {
+        objects.emplace_back(new BenchEvent(i, periods[i % 6],
+                                            prios[i % 3], i + 1,
+                                            objects, hash));
+    }
+    for (auto &obj : objects)
+        eq.schedule(obj.get(), obj->period * (1 + obj->id % 7));
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t n = 0; n < num_events; n++)
+        eq.serviceOne();
+    auto end = std::chrono::steady_clock::now();
+
+    for (auto &obj : objects) {
+        if (obj->scheduled())
+            eq.deschedule(obj.get());
+    }
+    curEventQueue(nullptr);
+
+    return { std::chrono::duration<double>(end - start).count(), hash };
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    int num_objects = argc > 1 ? atoi(argv[1]) : 4096;
+    uint64_t num_events = argc > 2 ? strtoull(argv[2], nullptr, 0) :
+        1000000;
+
+    Result list = run(EventQueue::Backend::LinkedList, num_objects,
+                      num_events);
+    Result calendar = run(EventQueue::Backend::Calendar, num_objects,
+                          num_events);
+
+    cprintf("%d objects, %d events\n", num_objects, num_events);
+    cprintf("linked list: %.3fs, %.0f events/s\n", list.seconds,
+            num_events / list.seconds);
+    cprintf("calendar:    %.3fs, %.0f events/s\n", calendar.seconds,
+            num_events / calendar.seconds);
+
+    if (list.hash != calendar.hash) {
+        cprintf("event order differs: %#x vs %#x\n", list.hash,
+                calendar.hash);
+        return 1;
+    }
+    cprintf("same event order (hash %#x)\n", list.hash);
+    return 0;
+}
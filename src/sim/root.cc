@@ -188,6 +188,13 @@ Root::Root(const RootParams &p, int)
 
     simQuantum = p.sim_quantum;
 
+    // The main queues may already hold events
+    EventQueue::defaultBackend =
+        p.event_queue_backend == enums::calendar ?
+        EventQueue::Backend::Calendar : EventQueue::Backend::LinkedList;
+    for (uint32_t i = 0; i < numMainEventQueues; i++)
+        mainEventQueue[i]->setBackend(EventQueue::defaultBackend);
+
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
     // having a single global stat group for global stats. Merge that
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The AI_X-Lab Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script dumps a binary Garnet packet trace, as replayed by
+# GarnetTraceReplay, to the ASCII format read by encode_garnet_trace.py.
+# The trace is read in chunks, so it does not have to fit in memory.
+
+import sys
+
+from encode_garnet_trace import DEP, HEADER, MAGIC, RECORD, VERSION
+
+
+def read_exactly(trace, size):
+    data = trace.read(size)
+    if len(data) != size:
+        print("Unexpected end of trace")
+        exit(-1)
+    return data
+
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <binary input> <ASCII output>")
+        exit(-1)
+
+    with open(sys.argv[1], "rb") as trace, open(sys.argv[2], "w") as out:
+        magic, version, _, num_packets = HEADER.unpack(
+            read_exactly(trace, HEADER.size)
+        )
+        if magic != MAGIC or version != VERSION:
+            print("Not a version", VERSION, "Garnet trace")
+            exit(-1)
+
+        out.write("# time src dst vnet size deps\n")
+        for _ in range(num_packets):
+            time, src, dst, size, vnet, num_deps = RECORD.unpack(
+                read_exactly(trace, RECORD.size)
+            )
+            deps = [
+                DEP.unpack(read_exactly(trace, DEP.size))[0]
+                for _ in range(num_deps)
+            ]
+            out.write(
+                " ".join(str(f) for f in [time, src, dst, vnet, size] + deps)
+                + "\n"
+            )
+
+    print("Decoded", num_packets, "packets")
+
+
+if __name__ == "__main__":
+    main()
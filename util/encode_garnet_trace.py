@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The AI_X-Lab Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script encodes an ASCII Garnet packet trace into the binary format
+# replayed by GarnetTraceReplay. Each line of the ASCII trace describes a
+# packet, in nondecreasing time order:
+#
+#   <time> <src> <dst> <vnet> <size> [<dep> ...]
+#
+# where time is the injection cycle, src and dst are global node ids,
+# size is in bytes and the optional deps are the line numbers, counting
+# packets from 0, of earlier packets that must be delivered first. Empty
+# lines and lines starting with # are ignored.
+
+import struct
+import sys
+
+HEADER = struct.Struct("<8sIIQ")
+RECORD = struct.Struct("<QIIIHH")
+DEP = struct.Struct("<Q")
+MAGIC = b"GNTRACE\0"
+VERSION = 1
+
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <ASCII input> <binary output>")
+        exit(-1)
+
+    with open(sys.argv[1]) as ascii_in, open(sys.argv[2], "wb") as out:
+        # The number of packets is patched in once they are all written
+        out.write(HEADER.pack(MAGIC, VERSION, 0, 0))
+        num_packets = 0
+        last_time = 0
+        for line_no, line in enumerate(ascii_in, 1):
+            fields = line.split()
+            if not fields or fields[0].startswith("#"):
+                continue
+            if len(fields) < 5:
+                print(f"Line {line_no}: expected time, src, dst, vnet, size")
+                exit(-1)
+            time, src, dst, vnet, size = [int(f) for f in fields[:5]]
+            deps = [int(f) for f in fields[5:]]
+            if size <= 0:
+                print(f"Line {line_no}: packets must have a positive size")
+                exit(-1)
+            if time < last_time:
+                print(f"Line {line_no}: time goes backwards")
+                exit(-1)
+            if any(dep < 0 or dep >= num_packets for dep in deps):
+                print(f"Line {line_no}: depends on a later packet")
+                exit(-1)
+            last_time = time
+            out.write(RECORD.pack(time, src, dst, size, vnet, len(deps)))
+            for dep in deps:
+                out.write(DEP.pack(dep))
+            num_packets += 1
+
+        out.seek(0)
+        out.write(HEADER.pack(MAGIC, VERSION, 0, num_packets))
+
+    print("Encoded", num_packets, "packets")
+
+
+if __name__ == "__main__":
+    main()
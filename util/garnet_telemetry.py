@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The AI_X-Lab Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script reads the time series written by the Garnet telemetry
+# sampler (--garnet-telemetry-interval) and renders one heatmap per
+# z-plane of a 3D torus, or prints the busiest routers of any other
+# topology. The metrics are computed per router, averaged over the
+# selected samples:
+#
+#   link  fraction of cycles the router's outgoing router-to-router
+#         links carried a flit (optionally of one direction only)
+#   sa    switch allocator grants per cycle
+#   vc    flits buffered per input VC
+#
+# Requires numpy, and matplotlib to draw the heatmaps.
+
+import argparse
+import struct
+import sys
+
+import numpy as np
+
+MAGIC = b"GNTELEM\0"
+VERSION = 1
+HEADER = struct.Struct("<8sIIQIIIIiiiI")
+LINK = np.dtype(
+    [("src", "<i4"), ("dest", "<i4"), ("type", "<i4"), ("outport", "<i4")]
+)
+ROUTER = np.dtype([("inports", "<u4"), ("vcs", "<u4")])
+
+# link_type and PortDirectionId of CommonTypes.hh
+INT_LINK = 2
+DIRECTIONS = ["Local", "East", "West", "North", "South", "Up", "Down"]
+
+
+class Telemetry:
+    def __init__(self, path):
+        data = open(path, "rb").read()
+        fields = HEADER.unpack_from(data)
+        if fields[0] != MAGIC or fields[1] != VERSION:
+            sys.exit(f"{path} is not a version {VERSION} telemetry file")
+        (
+            _,
+            _,
+            self.interval,
+            self.clock_period,
+            samples,
+            links,
+            routers,
+            vcs,
+            *dims,
+            _,
+        ) = fields
+        self.dims = dims
+
+        offset = HEADER.size
+
+        def take(dtype, count):
+            nonlocal offset
+            array = np.frombuffer(data, dtype, count, offset)
+            offset += array.nbytes
+            return array
+
+        self.links = take(LINK, links)
+        self.routers = take(ROUTER, routers)
+        self.ticks = take("<u8", samples)
+        self.link_flits = take("<u4", samples * links).reshape(samples, -1)
+        self.sa_grants = take("<u4", samples * routers).reshape(samples, -1)
+        self.vc_occupancy = take("u1", samples * vcs).reshape(samples, -1)
+
+    @property
+    def num_routers(self):
+        return len(self.routers)
+
+    def router_metric(self, metric, first, last, direction=None):
+        """Per-router average of metric over samples [first, last)"""
+        cycles = max(1, (last - first)) * self.interval
+        if metric == "link":
+            mask = self.links["type"] == INT_LINK
+            if direction is not None:
+                mask &= self.links["outport"] == direction
+            flits = self.link_flits[first:last].sum(axis=0)[mask]
+            src = self.links["src"][mask]
+            busy = np.bincount(src, flits, self.num_routers)
+            count = np.bincount(src, minlength=self.num_routers)
+            return busy / np.maximum(count, 1) / cycles
+        if metric == "sa":
+            return self.sa_grants[first:last].sum(axis=0) / cycles
+        # Mean over the samples, then over the VCs of each router
+        per_vc = self.vc_occupancy[first:last].mean(axis=0)
+        sizes = self.routers["inports"] * self.routers["vcs"]
+        owner = np.repeat(np.arange(self.num_routers), sizes)
+        total = np.bincount(owner, per_vc, self.num_routers)
+        return total / np.maximum(sizes, 1)
+
+
+def plot_planes(values, dims, title, output):
+    import matplotlib
+
+    matplotlib.use("Agg")
+    import matplotlib.pyplot as plt
+
+    x, y, z = dims
+    # Router id = x + y * X + z * X * Y, as in RoutingUnit.cc
+    planes = values.reshape(z, y, x)
+    cols = min(z, 4)
+    rows = (z + cols - 1) // cols
+    fig, axes = plt.subplots(
+        rows, cols, figsize=(3.5 * cols, 3 * rows), squeeze=False
+    )
+    vmax = max(values.max(), 1e-9)
+    for plane in range(rows * cols):
+        ax = axes[plane // cols][plane % cols]
+        if plane >= z:
+            ax.axis("off")
+            continue
+        image = ax.imshow(
+            planes[plane], origin="lower", vmin=0, vmax=vmax, cmap="inferno"
+        )
+        ax.set_title(f"z = {plane}")
+        ax.set_xlabel("x")
+        ax.set_ylabel("y")
+    fig.colorbar(image, ax=axes.ravel().tolist())
+    fig.suptitle(title)
+    fig.savefig(output, dpi=120)
+    print("Wrote", output)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Summarize a Garnet telemetry file"
+    )
+    parser.add_argument("file", help="telemetry file (garnet_telemetry.bin)")
+    parser.add_argument(
+        "--metric", choices=["link", "sa", "vc"], default="link"
+    )
+    parser.add_argument(
+        "--direction",
+        choices=DIRECTIONS[1:],
+        help="only count the links leaving in this direction",
+    )
+    parser.add_argument(
+        "--first", type=int, default=0, help="first sample to average"
+    )
+    parser.add_argument(
+        "--last", type=int, default=None, help="sample to stop before"
+    )
+    parser.add_argument("--output", help="heatmap image (default: PNG)")
+    parser.add_argument(
+        "--top", type=int, default=10, help="busiest routers to print"
+    )
+    args = parser.parse_args()
+
+    telemetry = Telemetry(args.file)
+    samples = len(telemetry.ticks)
+    if samples == 0:
+        sys.exit("No samples in " + args.file)
+    first = max(0, args.first if args.first >= 0 else samples + args.first)
+    last = samples if args.last is None else min(args.last, samples)
+    if first >= last:
+        sys.exit(f"Empty sample range [{first}, {last})")
+
+    direction = None
+    if args.direction is not None:
+        direction = DIRECTIONS.index(args.direction)
+    values = telemetry.router_metric(args.metric, first, last, direction)
+
+    period = telemetry.interval * telemetry.clock_period
+    start = max(0, int(telemetry.ticks[first]) - period)
+    print(
+        f"{samples} samples every {telemetry.interval} cycles, "
+        f"averaging ticks {start}-{telemetry.ticks[last - 1]}"
+    )
+    print(f"{args.metric}: mean {values.mean():.4f} max {values.max():.4f}")
+    for router in np.argsort(values)[::-1][: args.top]:
+        print(f"  router {router:5d}  {values[router]:.4f}")
+
+    x, y, z = telemetry.dims
+    if x * y * z != telemetry.num_routers:
+        print("Not a 3D torus, no heatmap drawn")
+        return
+    output = args.output or f"garnet_telemetry_{args.metric}.png"
+    title = f"{args.metric}, samples {first}-{last - 1}"
+    if args.direction is not None:
+        title += f", {args.direction} links"
+    plot_planes(values, telemetry.dims, title, output)
+
+
+if __name__ == "__main__":
+    main()